@@ -0,0 +1,23 @@
+#pragma once
+#include <SDL3/SDL_render.h>
+
+#include <vector>
+
+#include "benchmark.h"
+#include "core/frameArena.h"
+#include "core/jobSystem.h"
+#include "core/resourceManager.h"
+
+// what the level benchmarks share: a software renderer and the loaded sheets
+struct LevelBenchContext
+{
+    SDL_Renderer* renderer = nullptr;
+    ResourceManager* resources = nullptr;
+    JobSystem* jobs = nullptr;
+    FrameArena* frameArena = nullptr;
+};
+
+// single systems on synthetic data: timers, animation, sweeps, the broadphase, bullets
+void AddMicroBenchmarks(std::vector<BenchCase>& cases);
+// whole ticks of generated scenes, timed per phase through LevelStats
+void AddLevelBenchmarks(std::vector<BenchCase>& cases, const LevelBenchContext& context);
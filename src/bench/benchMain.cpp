@@ -0,0 +1,148 @@
+#include <SDL3/SDL.h>
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "benchCases.h"
+#include "game/assetNames.h"
+
+// Benchmarks without a display: the dummy video driver and a software renderer into a
+// plain surface, like a headless galaxy run.
+//   galaxy_bench [--filter TEXT] [--samples N] [--list]
+//                [--out RESULTS.json] [--compare BASELINE.json] [--threshold PERCENT]
+// --compare exits with 1 when a median got slower than the baseline by more than the
+// threshold (default 10%), so a saved baseline gates a change.
+struct BenchOptions
+{
+    std::string filter;
+    int samples = 10;
+    bool list = false;
+    std::string outPath;
+    std::string comparePath;
+    double thresholdPercent = 10.0;
+};
+
+static bool ParseOptions(int argc, char* argv[], BenchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        char* end = nullptr;
+
+        if (arg == "--filter" && value)
+        {
+            options.filter = value;
+            i++;
+        }
+        else if (arg == "--samples" && value)
+        {
+            options.samples = static_cast<int>(std::strtol(value, &end, 10));
+            if (end == value || *end != '\0' || options.samples < 1)
+            {
+                SDL_Log("Invalid --samples value: %s", value);
+                return false;
+            }
+            i++;
+        }
+        else if (arg == "--list")
+        {
+            options.list = true;
+        }
+        else if (arg == "--out" && value)
+        {
+            options.outPath = value;
+            i++;
+        }
+        else if (arg == "--compare" && value)
+        {
+            options.comparePath = value;
+            i++;
+        }
+        else if (arg == "--threshold" && value)
+        {
+            options.thresholdPercent = std::strtod(value, &end);
+            if (end == value || *end != '\0' || options.thresholdPercent < 0.0)
+            {
+                SDL_Log("Invalid --threshold value: %s", value);
+                return false;
+            }
+            i++;
+        }
+        else
+        {
+            SDL_Log("Unknown or incomplete option: %s", argv[i]);
+            SDL_Log("Usage: galaxy_bench [--filter TEXT] [--samples N] [--list]\n"
+                    "                    [--out RESULTS.json] [--compare BASELINE.json]\n"
+                    "                    [--threshold PERCENT]");
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+        return 1;
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_VIDEO))
+    {
+        SDL_Log("SDL_Init failed: %s", SDL_GetError());
+        return 1;
+    }
+    // the same logical size the game renders at
+    SDL_Surface* target = SDL_CreateSurface(640, 320, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr)
+    {
+        SDL_Log("Software renderer failed: %s", SDL_GetError());
+        SDL_DestroySurface(target);
+        SDL_Quit();
+        return 1;
+    }
+
+    int exitCode = 0;
+    {
+        const char* basePath = SDL_GetBasePath();
+        ResourceManager resources(renderer, basePath ? basePath : "");
+        for (const auto& sheet : BuiltinSheets)
+            resources.LoadTextureAsync(sheet.name, sheet.file);
+        resources.WaitForLoads();
+        JobSystem jobs;
+        FrameArena frameArena;
+
+        std::vector<BenchCase> cases;
+        AddMicroBenchmarks(cases);
+        if (resources.BuildAtlas())
+            AddLevelBenchmarks(cases, {renderer, &resources, &jobs, &frameArena});
+        else
+            SDL_Log("No sprite sheets next to the executable, level benchmarks skipped");
+
+        if (options.list)
+        {
+            for (const BenchCase& benchCase : cases)
+                SDL_Log("%s", benchCase.name.c_str());
+        }
+        else
+        {
+            std::vector<BenchResult> results =
+                RunBenchmarks(cases, options.filter, options.samples);
+            if (!options.outPath.empty() && !WriteResults(options.outPath, results))
+                exitCode = 1;
+            std::vector<BenchResult> baseline;
+            if (!options.comparePath.empty() &&
+                (!ReadResults(options.comparePath, baseline) ||
+                 !CompareResults(baseline, results, options.thresholdPercent)))
+                exitCode = 1;
+        }
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    return exitCode;
+}
@@ -0,0 +1,172 @@
+#include "benchmark.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+// untimed samples first, they fault in memory and settle the caches
+static const int WARMUP_SAMPLES = 2;
+
+static volatile double keepAliveSink = 0.0;
+
+void KeepAlive(double value) { keepAliveSink = value; }
+
+std::vector<BenchResult> RunBenchmarks(const std::vector<BenchCase>& cases,
+                                       const std::string& filter, int samples)
+{
+    std::vector<BenchResult> results;
+    std::printf("%-48s %14s %14s\n", "benchmark", "median ns", "min ns");
+    for (const BenchCase& benchCase : cases)
+    {
+        if (benchCase.name.find(filter) == std::string::npos)
+            continue;
+
+        BenchSampler sampler = benchCase.setup();
+        if (!sampler)
+        {
+            SDL_Log("Benchmark %s could not be set up, skipped", benchCase.name.c_str());
+            continue;
+        }
+
+        const size_t metricCount = benchCase.metrics.size();
+        std::vector<double> sample(metricCount);
+        // one row per sample, metrics side by side
+        std::vector<double> timings;
+        timings.reserve(samples * metricCount);
+        for (int s = 0; s < WARMUP_SAMPLES + samples; s++)
+        {
+            sampler(sample);
+            if (s >= WARMUP_SAMPLES)
+                timings.insert(timings.end(), sample.begin(), sample.end());
+        }
+
+        for (size_t m = 0; m < metricCount; m++)
+        {
+            std::vector<double> values;
+            for (size_t s = m; s < timings.size(); s += metricCount)
+                values.push_back(timings[s]);
+            std::sort(values.begin(), values.end());
+
+            BenchResult result;
+            result.name = benchCase.name + "/" + benchCase.metrics[m];
+            result.medianNs = values[values.size() / 2];
+            result.minNs = values.front();
+            std::printf("%-48s %14.2f %14.2f\n", result.name.c_str(), result.medianNs,
+                        result.minNs);
+            results.push_back(result);
+        }
+        std::fflush(stdout);
+    }
+    return results;
+}
+
+bool WriteResults(const std::string& path, const std::vector<BenchResult>& results)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        SDL_Log("Cannot write %s", path.c_str());
+        return false;
+    }
+    std::fputs("{\"benchmarks\":[", file);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        std::fprintf(file, "%s\n{\"name\":\"%s\",\"median_ns\":%.3f,\"min_ns\":%.3f}",
+                     i == 0 ? "" : ",", results[i].name.c_str(), results[i].medianNs,
+                     results[i].minNs);
+    }
+    std::fputs("\n]}\n", file);
+    bool written = std::ferror(file) == 0;
+    written = std::fclose(file) == 0 && written;
+    if (!written)
+        SDL_Log("Cannot write %s", path.c_str());
+    return written;
+}
+
+// number following "key": at or after pos, false when the key is missing
+static bool ReadNumber(const std::string& text, size_t& pos, const char* key, double& out)
+{
+    pos = text.find(key, pos);
+    if (pos == std::string::npos)
+        return false;
+    const char* start = text.c_str() + pos + std::char_traits<char>::length(key);
+    char* end = nullptr;
+    out = std::strtod(start, &end);
+    pos = end - text.c_str();
+    return end != start;
+}
+
+bool ReadResults(const std::string& path, std::vector<BenchResult>& results)
+{
+    std::ifstream source(path, std::ios::binary);
+    if (!source)
+    {
+        SDL_Log("Cannot read %s", path.c_str());
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+
+    // only the layout WriteResults produces is understood, names never hold quotes
+    const std::string nameKey = "\"name\":\"";
+    results.clear();
+    size_t pos = 0;
+    while ((pos = text.find(nameKey, pos)) != std::string::npos)
+    {
+        pos += nameKey.size();
+        size_t nameEnd = text.find('"', pos);
+        if (nameEnd == std::string::npos)
+            break;
+        BenchResult result;
+        result.name = text.substr(pos, nameEnd - pos);
+        pos = nameEnd;
+        if (!ReadNumber(text, pos, "\"median_ns\":", result.medianNs) ||
+            !ReadNumber(text, pos, "\"min_ns\":", result.minNs))
+        {
+            SDL_Log("Baseline %s: no timings for %s", path.c_str(), result.name.c_str());
+            return false;
+        }
+        results.push_back(result);
+    }
+    if (results.empty())
+    {
+        SDL_Log("Baseline %s holds no results", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CompareResults(const std::vector<BenchResult>& baseline,
+                    const std::vector<BenchResult>& current, double thresholdPercent)
+{
+    int regressions = 0;
+    std::printf("\n%-48s %14s %14s %9s\n", "benchmark", "baseline ns", "current ns", "change");
+    for (const BenchResult& result : current)
+    {
+        auto base = std::find_if(baseline.begin(), baseline.end(),
+                                 [&](const BenchResult& b) { return b.name == result.name; });
+        if (base == baseline.end() || base->medianNs <= 0.0)
+        {
+            std::printf("%-48s %14s %14.2f %9s\n", result.name.c_str(), "-", result.medianNs,
+                        "new");
+            continue;
+        }
+        double change = (result.medianNs / base->medianNs - 1.0) * 100.0;
+        bool regressed = change > thresholdPercent;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-48s %14.2f %14.2f %+8.1f%%%s\n", result.name.c_str(), base->medianNs,
+                    result.medianNs, change, regressed ? "  REGRESSION" : "");
+    }
+    if (regressions > 0)
+    {
+        std::printf("%d benchmarks slower than the baseline by more than %.1f%%\n", regressions,
+                    thresholdPercent);
+        return false;
+    }
+    std::printf("no regressions beyond %.1f%%\n", thresholdPercent);
+    return true;
+}
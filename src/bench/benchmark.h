@@ -0,0 +1,42 @@
+#pragma once
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+// Measures one sample: nanoseconds per operation for each metric of the case. A
+// sampler repeats its operation often enough on its own to be timed reliably.
+using BenchSampler = std::function<void(std::span<double> nsPerOp)>;
+
+struct BenchCase
+{
+    // "group/params", results are reported as "group/params/metric"
+    std::string name;
+    std::vector<std::string> metrics;
+    // builds the scene and returns its sampler, only called for selected cases
+    std::function<BenchSampler()> setup;
+};
+
+struct BenchResult
+{
+    std::string name;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+};
+
+// Runs every case whose name contains filter: a warm-up, then samples timed ones.
+// Each result is printed as soon as its case finishes.
+std::vector<BenchResult> RunBenchmarks(const std::vector<BenchCase>& cases,
+                                       const std::string& filter, int samples);
+
+// baseline files are the JSON written here, false (with an SDL_Log) on failure
+bool WriteResults(const std::string& path, const std::vector<BenchResult>& results);
+bool ReadResults(const std::string& path, std::vector<BenchResult>& results);
+
+// prints current against baseline, false if a median got slower by more than
+// thresholdPercent
+bool CompareResults(const std::vector<BenchResult>& baseline,
+                    const std::vector<BenchResult>& current, double thresholdPercent);
+
+// stores a value the optimizer can not see through, so the work producing it stays
+void KeepAlive(double value);
@@ -0,0 +1,70 @@
+#include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
+
+#include <memory>
+#include <string>
+
+#include "benchCases.h"
+#include "game/Level.h"
+#include "game/stressScene.h"
+
+// ticks per sample, one second of play
+static const uint32_t SAMPLE_TICKS = 60;
+
+static void AddLevelScene(std::vector<BenchCase>& cases, const LevelBenchContext& context,
+                          StressSceneParams params)
+{
+    std::string name = "level/e" + std::to_string(params.enemies) + "_m" +
+                       std::to_string(params.cols) + "x" + std::to_string(params.rows);
+    if (params.fireRate > 0.0f)
+        name += "_f" + std::to_string(static_cast<int>(params.fireRate));
+    cases.push_back(
+        {name,
+         {"update", "collision", "ground", "render"},
+         [context, params]() -> BenchSampler
+         {
+             auto level = std::make_shared<Level>(*context.jobs, *context.frameArena);
+             if (!level->LoadSource(context.resources, GenerateStressScene(params, 1), 1))
+                 return nullptr;
+             level->SetAutoFire(params.fireRate);
+             return [context, level](std::span<double> ns)
+             {
+                 // the player stands still, so every sample simulates the same chunks
+                 const InputState input;
+                 uint64_t update = 0, collision = 0, ground = 0, render = 0;
+                 for (uint32_t t = 0; t < SAMPLE_TICKS; t++)
+                 {
+                     context.frameArena->Reset();
+                     level->Update(1.0f / 60.0f, input);
+                     const LevelStats& stats = level->GetStats();
+                     update += stats.updateNs;
+                     collision += stats.collisionNs;
+                     ground += stats.groundNs;
+
+                     // the present rasterizes the queued draws, it counts as render time
+                     uint64_t renderStart = SDL_GetTicksNS();
+                     SDL_RenderClear(context.renderer);
+                     level->Render(context.renderer, false, 1.0f);
+                     SDL_RenderPresent(context.renderer);
+                     render += SDL_GetTicksNS() - renderStart;
+                 }
+                 ns[0] = static_cast<double>(update) / SAMPLE_TICKS;
+                 ns[1] = static_cast<double>(collision) / SAMPLE_TICKS;
+                 ns[2] = static_cast<double>(ground) / SAMPLE_TICKS;
+                 ns[3] = static_cast<double>(render) / SAMPLE_TICKS;
+             };
+         }});
+}
+
+void AddLevelBenchmarks(std::vector<BenchCase>& cases, const LevelBenchContext& context)
+{
+    // 48x16 fits the active chunks, so every enemy is simulated; the large map streams
+    const StressSceneParams scenes[] = {
+        {48, 16, 0.05f, 10, 0.0f},       {48, 16, 0.05f, 100, 0.0f},
+        {48, 16, 0.05f, 1000, 0.0f},     {48, 16, 0.05f, 10000, 0.0f},
+        {48, 16, 0.05f, 1000, 60.0f},    {48, 16, 0.05f, 1000, 600.0f},
+        {1024, 128, 0.05f, 10000, 0.0f},
+    };
+    for (const StressSceneParams& params : scenes)
+        AddLevelScene(cases, context, params);
+}
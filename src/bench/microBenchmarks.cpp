@@ -0,0 +1,204 @@
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include <cmath>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+
+#include "benchCases.h"
+#include "core/animation.h"
+#include "core/spatialHash.h"
+#include "core/sweep.h"
+#include "core/timer.h"
+#include "game/animationClips.h"
+#include "game/bullet.h"
+
+// fixed seed, every build benchmarks the same data
+static const uint64_t DATA_SEED = 1;
+static const float TICK = 1.0f / 60.0f;
+
+static double NsSince(uint64_t start, uint64_t operations)
+{
+    return static_cast<double>(SDL_GetTicksNS() - start) / static_cast<double>(operations);
+}
+
+static float RandomRange(uint64_t& rng, float low, float high)
+{
+    return low + SDL_randf_r(&rng) * (high - low);
+}
+
+static void AddTimerStep(std::vector<BenchCase>& cases)
+{
+    cases.push_back({"timer/step", {"ns_per_step"}, []() -> BenchSampler
+                     {
+                         const uint32_t count = 4096;
+                         const uint32_t steps = 64;
+                         auto timers = std::make_shared<std::vector<Timer>>(count, Timer(0.2f));
+                         return [timers, count, steps](std::span<double> ns)
+                         {
+                             uint64_t timeouts = 0;
+                             uint64_t start = SDL_GetTicksNS();
+                             for (uint32_t s = 0; s < steps; s++)
+                             {
+                                 for (Timer& timer : *timers)
+                                 {
+                                     timer.step(TICK);
+                                     timeouts += timer.isTimeout();
+                                 }
+                             }
+                             ns[0] = NsSince(start, uint64_t(count) * steps);
+                             KeepAlive(static_cast<double>(timeouts));
+                         };
+                     }});
+}
+
+static void AddAnimation(std::vector<BenchCase>& cases, uint32_t count)
+{
+    cases.push_back(
+        {"animation/n" + std::to_string(count),
+         {"ns_per_step", "ns_per_frame_src"},
+         [count]() -> BenchSampler
+         {
+             auto states = std::make_shared<std::vector<AnimationState>>(count);
+             uint64_t rng = DATA_SEED;
+             for (AnimationState& state : *states)
+             {
+                 state.clip = static_cast<uint8_t>(SDL_rand_r(&rng, std::size(AnimationClips)));
+                 state.time = RandomRange(rng, 0.0f, AnimationClips[state.clip].length);
+             }
+             return [states, count](std::span<double> ns)
+             {
+                 const uint32_t rounds = 16;
+                 uint64_t start = SDL_GetTicksNS();
+                 for (uint32_t r = 0; r < rounds; r++)
+                     AdvanceAnimations(AnimationClips, states->data(), count, TICK);
+                 ns[0] = NsSince(start, uint64_t(count) * rounds);
+
+                 AtlasRegion sheet;
+                 float sum = 0.0f;
+                 start = SDL_GetTicksNS();
+                 for (uint32_t r = 0; r < rounds; r++)
+                 {
+                     for (const AnimationState& state : *states)
+                         sum += GetFrameSrc(AnimationClips, state, sheet).x;
+                 }
+                 ns[1] = NsSince(start, uint64_t(count) * rounds);
+                 KeepAlive(sum);
+             };
+         }});
+}
+
+static void AddSweepBox(std::vector<BenchCase>& cases)
+{
+    cases.push_back(
+        {"sweep/box",
+         {"ns_per_test"},
+         []() -> BenchSampler
+         {
+             // movers around a 32px tile, about half of them reach it
+             struct Test
+             {
+                 SDL_FRect box;
+                 glm::vec2 delta;
+             };
+             auto tests = std::make_shared<std::vector<Test>>(4096);
+             uint64_t rng = DATA_SEED;
+             for (Test& test : *tests)
+             {
+                 test.box = {RandomRange(rng, -64.0f, 64.0f), RandomRange(rng, -64.0f, 64.0f),
+                             16.0f, 24.0f};
+                 test.delta = {RandomRange(rng, -48.0f, 48.0f), RandomRange(rng, -48.0f, 48.0f)};
+             }
+             return [tests](std::span<double> ns)
+             {
+                 const SDL_FRect tile = {0.0f, 0.0f, 32.0f, 32.0f};
+                 const uint32_t rounds = 64;
+                 float sum = 0.0f;
+                 uint64_t start = SDL_GetTicksNS();
+                 for (uint32_t r = 0; r < rounds; r++)
+                 {
+                     for (const Test& test : *tests)
+                     {
+                         SweepHit hit;
+                         if (SweepBox(test.box, test.delta, tile, hit))
+                             sum += hit.time;
+                     }
+                 }
+                 ns[0] = NsSince(start, tests->size() * rounds);
+                 KeepAlive(sum);
+             };
+         }});
+}
+
+static void AddSpatialHash(std::vector<BenchCase>& cases, uint32_t count)
+{
+    cases.push_back(
+        {"spatial_hash/n" + std::to_string(count),
+         {"ns_per_insert", "ns_per_query"},
+         [count]() -> BenchSampler
+         {
+             // constant density: the area grows with the body count
+             auto rects = std::make_shared<std::vector<SDL_FRect>>(count);
+             float side = 64.0f * std::sqrt(static_cast<float>(count));
+             uint64_t rng = DATA_SEED;
+             for (SDL_FRect& rect : *rects)
+                 rect = {RandomRange(rng, 0.0f, side), RandomRange(rng, 0.0f, side), 16.0f, 24.0f};
+             auto hash = std::make_shared<SpatialHash>();
+             return [rects, hash, count](std::span<double> ns)
+             {
+                 uint64_t start = SDL_GetTicksNS();
+                 hash->Clear();
+                 for (uint32_t i = 0; i < count; i++)
+                     hash->Insert(i, (*rects)[i]);
+                 hash->Build();
+                 ns[0] = NsSince(start, count);
+
+                 uint64_t found = 0;
+                 start = SDL_GetTicksNS();
+                 for (const SDL_FRect& rect : *rects)
+                     hash->Query(rect, [&found](uint32_t, const SDL_FRect&) { found++; });
+                 ns[1] = NsSince(start, count);
+                 KeepAlive(static_cast<double>(found));
+             };
+         }});
+}
+
+static void AddBulletTick(std::vector<BenchCase>& cases, uint32_t count)
+{
+    cases.push_back({"bullets/b" + std::to_string(count),
+                     {"ns_per_tick"},
+                     [count]() -> BenchSampler
+                     {
+                         auto pool = std::make_shared<BulletPool>();
+                         uint64_t rng = DATA_SEED;
+                         for (uint32_t i = 0; i < count; i++)
+                             pool->Spawn({0.0f, RandomRange(rng, 0.0f, 320.0f)}, 1.0f, rng);
+                         return [pool](std::span<double> ns)
+                         {
+                             // bounds far enough that nothing retires during the run
+                             const uint32_t ticks = 64;
+                             uint64_t start = SDL_GetTicksNS();
+                             for (uint32_t t = 0; t < ticks; t++)
+                             {
+                                 pool->SnapshotPositions();
+                                 pool->Retire(-1e9f, 1e9f);
+                                 pool->Integrate(TICK);
+                             }
+                             ns[0] = NsSince(start, ticks);
+                             KeepAlive(pool->posX[0]);
+                         };
+                     }});
+}
+
+void AddMicroBenchmarks(std::vector<BenchCase>& cases)
+{
+    AddTimerStep(cases);
+    for (uint32_t count : {1000u, 10000u})
+        AddAnimation(cases, count);
+    AddSweepBox(cases);
+    for (uint32_t count : {1000u, 10000u, 100000u})
+        AddSpatialHash(cases, count);
+    for (uint32_t count : {100u, 1000u, 4000u})
+        AddBulletTick(cases, count);
+}
@@ -1,45 +1,78 @@
 #pragma once
 #include <SDL3/SDL_rect.h>
 
-#include "timer.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
-class Animation
+#include "atlasPacker.h"
+
+// Immutable clip: one row of equally sized frames on a sprite sheet, looping over
+// length seconds. Frame rects are precomputed relative to the sheet, so picking a
+// frame is a multiply and a table lookup. Built-in clips are constexpr tables that
+// every instance shares.
+struct AnimationClip
 {
-   private:
-    int frameCount;
-    int row_animation;
-    int frameWidth;
-    int frameHeight;
-    Timer timer;
-
-   public:
-    Animation() : frameCount(0), row_animation(0), frameWidth(0), frameHeight(0), timer(0) {}
-    Animation(int frame_count, float length, int row, int w, int h)
-        : frameCount(frame_count), row_animation(row), frameWidth(w), frameHeight(h), timer(length)
+    static constexpr int MAX_FRAMES = 8;
+
+    float length = 0.0f;
+    float framesPerSecond = 0.0f;
+    int frameCount = 0;
+    std::array<SDL_FRect, MAX_FRAMES> frames{};
+};
+
+constexpr AnimationClip MakeClip(int frameCount, float length, int row, int w, int h)
+{
+    AnimationClip clip;
+    clip.length = length;
+    clip.framesPerSecond = frameCount / length;
+    clip.frameCount = frameCount;
+    for (int i = 0; i < frameCount; i++)
     {
+        clip.frames[i] = {static_cast<float>(i * w), static_cast<float>(row * h),
+                          static_cast<float>(w), static_cast<float>(h)};
     }
+    return clip;
+}
+
+// Per-instance playback, all an entity carries for its animation. clip indexes the
+// clip table the owner passes to the functions below.
+struct AnimationState
+{
+    uint8_t clip = 0;
+    bool looped = false;  // the last step wrapped past the end of the clip
+    float time = 0.0f;
+};
 
-    float getLength() const { return timer.getLength(); }
-    SDL_FRect GetCurrentFrameSrc() const
+// advances one playback; a step longer than the clip can wrap more than once
+inline void StepAnimation(const AnimationClip* clips, AnimationState& state, float deltaTime)
+{
+    const float length = clips[state.clip].length;
+    state.looped = false;
+    state.time += deltaTime;
+    while (state.time >= length)
     {
-        int currentFrameIndex = 0;
-        if (frameCount > 0)
-        {
-            currentFrameIndex = static_cast<int>(timer.getTime() / timer.getLength() * frameCount);
-            if (currentFrameIndex >= frameCount)
-            {
-                currentFrameIndex = frameCount - 1;
-            }
-        }
-        SDL_FRect src;
-        src.x = static_cast<float>(currentFrameIndex * frameWidth);
-        src.y = static_cast<float>(row_animation * frameHeight);  // Jump down to the correct row
-        src.w = static_cast<float>(frameWidth);
-        src.h = static_cast<float>(frameHeight);
-
-        return src;
+        state.time -= length;
+        state.looped = true;
     }
-    bool isDone() { return timer.isTimeout(); }
-    void reset() { timer.reset(); }
-    void step(float deltaTime) { timer.step(deltaTime); }
-};
+}
+
+// the batch pass: advances count playbacks in one linear sweep
+inline void AdvanceAnimations(const AnimationClip* clips, AnimationState* states, uint32_t count,
+                              float deltaTime)
+{
+    for (uint32_t i = 0; i < count; i++)
+        StepAnimation(clips, states[i], deltaTime);
+}
+
+// source rect of the current frame inside a sheet that was packed into an atlas page
+inline SDL_FRect GetFrameSrc(const AnimationClip* clips, const AnimationState& state,
+                             const AtlasRegion& sheet)
+{
+    const AnimationClip& clip = clips[state.clip];
+    int frame = std::min(static_cast<int>(state.time * clip.framesPerSecond), clip.frameCount - 1);
+    SDL_FRect src = clip.frames[frame];
+    src.x += sheet.rect.x;
+    src.y += sheet.rect.y;
+    return src;
+}
@@ -0,0 +1,176 @@
+#include "appConfig.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <climits>
+#include <cstdlib>
+#include <string_view>
+
+// catch-up ticks per frame past this only lengthen a hitch
+static const int MAX_STEPS_PER_FRAME = 100;
+
+static bool ParseInt(const char* text, int minValue, int maxValue, int& out)
+{
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value < minValue || value > maxValue)
+        return false;
+    out = static_cast<int>(value);
+    return true;
+}
+
+bool ParseCommandLine(int argc, char* argv[], AppConfig& config)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (arg == "--variable-step")
+        {
+            config.fixedStep = false;
+        }
+        else if (arg == "--tick-hz" && value)
+        {
+            if (!ParseInt(value, 1, MAX_TICK_HZ, config.tickHz))
+            {
+                SDL_Log("Invalid --tick-hz value: %s, expected 1 to %d", value, MAX_TICK_HZ);
+                return false;
+            }
+            i++;
+        }
+        else if (arg == "--pacing" && value)
+        {
+            std::string_view mode = value;
+            if (mode == "vsync")
+                config.pacing = AppConfig::PacingVsync;
+            else if (mode == "uncapped")
+                config.pacing = AppConfig::PacingUncapped;
+            else if (mode == "fixed")
+                config.pacing = AppConfig::PacingFixed;
+            else
+            {
+                SDL_Log("Invalid --pacing value: %s, expected vsync, uncapped or fixed", value);
+                return false;
+            }
+            i++;
+        }
+        else if (arg == "--fps" && value)
+        {
+            if (!ParseInt(value, 1, MAX_TARGET_FPS, config.targetFps))
+            {
+                SDL_Log("Invalid --fps value: %s, expected 1 to %d", value, MAX_TARGET_FPS);
+                return false;
+            }
+            config.pacing = AppConfig::PacingFixed;
+            i++;
+        }
+        else if (arg == "--headless")
+        {
+            config.headless = true;
+        }
+        else if (arg == "--ticks" && value)
+        {
+            int ticks = 0;
+            if (!ParseInt(value, 1, INT_MAX, ticks))
+            {
+                SDL_Log("Invalid --ticks value: %s, expected 1 to %d", value, INT_MAX);
+                return false;
+            }
+            config.benchTicks = static_cast<uint64_t>(ticks);
+            i++;
+        }
+        else if (arg == "--script" && value)
+        {
+            config.inputScript = value;
+            i++;
+        }
+        else if (arg == "--level" && value)
+        {
+            config.levelPath = value;
+            i++;
+        }
+        else if (arg == "--stress" && value)
+        {
+            if (!ParseStressScene(value, config.stressScene))
+                return false;
+            config.stress = true;
+            i++;
+        }
+        else if (arg == "--convert-level" && value && i + 2 < argc)
+        {
+            config.convertInput = value;
+            config.convertOutput = argv[i + 2];
+            i += 2;
+        }
+        else if (arg == "--trace" && value)
+        {
+            config.tracePath = value;
+            i++;
+        }
+        else if (arg == "--record" && value)
+        {
+            config.recordPath = value;
+            i++;
+        }
+        else if (arg == "--replay" && value)
+        {
+            config.replayPath = value;
+            i++;
+        }
+        else if (arg == "--seed" && value)
+        {
+            int seed = 0;
+            if (!ParseInt(value, 1, INT_MAX, seed))
+            {
+                SDL_Log("Invalid --seed value: %s, expected 1 to %d", value, INT_MAX);
+                return false;
+            }
+            config.seed = static_cast<uint64_t>(seed);
+            i++;
+        }
+        else if (arg == "--check-alloc" && value)
+        {
+            if (!ParseInt(value, 1, INT_MAX, config.allocCheckWarmup))
+            {
+                SDL_Log("Invalid --check-alloc value: %s, expected 1 to %d", value, INT_MAX);
+                return false;
+            }
+            i++;
+        }
+        else if (arg == "--max-steps" && value)
+        {
+            if (!ParseInt(value, 1, MAX_STEPS_PER_FRAME, config.maxStepsPerFrame))
+            {
+                SDL_Log("Invalid --max-steps value: %s, expected 1 to %d", value,
+                        MAX_STEPS_PER_FRAME);
+                return false;
+            }
+            i++;
+        }
+        else
+        {
+            SDL_Log("Unknown or incomplete option: %s", argv[i]);
+            SDL_Log("Usage: galaxy [--tick-hz N] [--max-steps N] [--variable-step]\n"
+                    "              [--pacing vsync|uncapped|fixed] [--fps N]\n"
+                    "              [--headless] [--ticks N] [--script TICKS:BUTTONS,...]\n"
+                    "              [--level FILE] [--convert-level IN.txt OUT.glvl]\n"
+                    "              [--trace OUT.json] [--check-alloc WARMUP_FRAMES]\n"
+                    "              [--record OUT.ginp] [--replay IN.ginp] [--seed N]\n"
+                    "              [--stress COLSxROWS[,DENSITY[,ENEMIES[,FIRE_RATE]]]]");
+            return false;
+        }
+    }
+    if (!config.recordPath.empty() && !config.replayPath.empty())
+    {
+        SDL_Log("Pick one of --record and --replay");
+        return false;
+    }
+    // a capture is a list of ticks, variable steps would not replay the same way
+    if (!config.fixedStep && (!config.recordPath.empty() || !config.replayPath.empty()))
+    {
+        SDL_Log("--record and --replay need fixed steps, drop --variable-step");
+        return false;
+    }
+    return true;
+}
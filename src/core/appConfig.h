@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "game/stressScene.h"
+
+// upper bounds of --tick-hz and --fps; a tick must stay a whole number of nanoseconds
+// well above zero, the step and the interpolation divide by it
+inline constexpr int MAX_TICK_HZ = 1000;
+inline constexpr int MAX_TARGET_FPS = 1000;
+
+// runtime options, filled from the command line in main()
+struct AppConfig
+{
+    // simulation runs at tickHz in fixed steps, rendering interpolates between ticks
+    bool fixedStep = true;
+    int tickHz = 60;
+    // catch-up ticks per rendered frame, any backlog past this is dropped
+    int maxStepsPerFrame = 5;
+
+    // how windowed frames are paced: vsync waits in the present, uncapped renders as fast
+    // as it can, fixed holds targetFps with a sleep-then-spin limiter. Without vsync
+    // support the vsync mode falls back to fixed at the display rate; headless runs are
+    // uncapped unless fixed is asked for
+    enum Pacing
+    {
+        PacingVsync,
+        PacingUncapped,
+        PacingFixed,
+    };
+    Pacing pacing = PacingVsync;
+    int targetFps = 60;
+
+    // headless benchmark: no window, software renderer, scripted input for benchTicks ticks
+    bool headless = false;
+    uint64_t benchTicks = 3600;
+    std::string inputScript;
+
+    // level to play, relative to the executable
+    std::string levelPath = "data/level1.glvl";
+    // --stress: play a generated scene instead of levelPath
+    bool stress = false;
+    StressSceneParams stressScene;
+    // --convert-level: turn a text level into a binary one and exit without a window
+    std::string convertInput;
+    std::string convertOutput;
+
+    // --trace: record profiler zones and write them as Chrome trace JSON on exit
+    std::string tracePath;
+
+    // --record writes the input of every tick to a capture, --replay plays one back
+    // instead of the keyboard or the script, with the tick rate and seed it was taken at
+    std::string recordPath;
+    std::string replayPath;
+    // seed of the level RNG, 0 picks one: 1 in headless runs, the clock otherwise
+    uint64_t seed = 0;
+
+    // --check-alloc: fail the run if anything allocates from the heap once
+    // allocCheckWarmup frames (ticks when headless) are done, 0 is off
+    int allocCheckWarmup = 0;
+};
+
+bool ParseCommandLine(int argc, char* argv[], AppConfig& config);
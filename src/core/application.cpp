@@ -9,11 +9,57 @@
 #include <SDL3/SDL_scancode.h>
 #include <SDL3/SDL_video.h>
 
+#include <atomic>
+#include <cstdio>
+
+#include "core/heapStats.h"
+#include "core/input.h"
+#include "core/profiler.h"
 #include "core/resourceManager.h"
+#include "game/assetNames.h"
+
+namespace
+{
+std::atomic<uint64_t> lateAllocations{0};
+
+// installed once warm-up is over, runs inside operator new so it must not allocate
+void CountLateAllocation(std::size_t size)
+{
+    // the first one is the interesting one, SDL_Log does not go through operator new
+    if (lateAllocations.fetch_add(1, std::memory_order_relaxed) == 0)
+        SDL_Log("Heap allocation of %zu bytes after warm-up", size);
+}
+}  // namespace
 
-bool Application::Initialize()
+bool Application::Initialize(const AppConfig& config)
 {
+    this->config = config;
     bool initSuccess = true;
+    if (config.headless)
+    {
+        // no display needed, the dummy driver works on CI boxes without a GPU
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+        std::string script =
+            config.inputScript.empty() ? InputScript::DefaultScript : config.inputScript;
+        if (!inputScript.Parse(script))
+            return false;
+    }
+    if (!config.replayPath.empty())
+    {
+        if (!recording.Load(config.replayPath))
+            return false;
+        // the capture decides the step, the seed and how long a headless run is
+        this->config.tickHz = recording.GetTickHz();
+        this->config.seed = recording.GetSeed();
+        this->config.benchTicks = recording.GetTickCount();
+    }
+    else if (config.seed == 0)
+    {
+        // headless runs default to one fixed seed so they are comparable
+        this->config.seed = config.headless ? 1 : SDL_GetPerformanceCounter();
+    }
+    if (!config.recordPath.empty())
+        recording.Begin(this->config.tickHz, this->config.seed);
     // Intialization of the sdl
     if (!SDL_Init(SDL_INIT_VIDEO))
     {
@@ -29,41 +75,58 @@ bool Application::Initialize()
                                  "Sdl3  Base Path Intialization Failed", nullptr);
         initSuccess = false;
     }
-    // creation of the Window
-    this->window =
-        SDL_CreateWindow("Sdl Demo", this->GAME_WIDTH, this->GAME_HEIGHT, SDL_WINDOW_RESIZABLE);
-
-    if (this->window == nullptr)
+    if (config.headless)
     {
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Window creating error",
-                                 this->window);
-        this->Destroy();
-        initSuccess = false;
+        // render into a plain surface with the software renderer
+        this->headlessTarget = SDL_CreateSurface(logWidth, logHeight, SDL_PIXELFORMAT_RGBA32);
+        if (this->headlessTarget)
+            this->renderer = SDL_CreateSoftwareRenderer(this->headlessTarget);
+        if (this->renderer == nullptr)
+        {
+            SDL_Log("Headless software renderer failed: %s", SDL_GetError());
+            return false;
+        }
     }
+    else
+    {
+        // creation of the Window
+        this->window = SDL_CreateWindow("Sdl Demo", this->GAME_WIDTH, this->GAME_HEIGHT,
+                                        SDL_WINDOW_RESIZABLE);
 
-    // create the renderer
+        if (this->window == nullptr)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error", "Window creating error",
+                                     this->window);
+            this->Destroy();
+            initSuccess = false;
+        }
 
-    this->renderer = SDL_CreateRenderer(this->window, nullptr);
-    if (this->renderer == nullptr)
-    {
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "error", "Render not able to intialize",
-                                 this->window);
-        this->Destroy();
-        initSuccess = false;
+        // create the renderer
+
+        this->renderer = SDL_CreateRenderer(this->window, nullptr);
+        if (this->renderer == nullptr)
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "error",
+                                     "Render not able to intialize", this->window);
+            this->Destroy();
+            initSuccess = false;
+        }
     }
 
     // loading the resources
+    PROFILE_ZONE("LoadAssets");
     this->resourceManager = new ResourceManager(renderer, this->basePath ? this->basePath : "");
 
-    resourceManager->LoadTexture("player", "data/player.png");
-    resourceManager->LoadTexture("ground", "data/Ground.png");
-    resourceManager->LoadTexture("panel", "data/Panel.png");
-    resourceManager->LoadTexture("grass", "data/Grass.png");
-    resourceManager->LoadTexture("brick", "data/Brick.png");
-    resourceManager->LoadTexture("background_1", "data/Background_1.png");
-    resourceManager->LoadTexture("background_2", "data/Background_2.png");
-    resourceManager->LoadTexture("bullet", "data/bullet-sheet.png");
-    resourceManager->LoadTexture("enemy", "data/player.png");
+    // decode every sheet in parallel, textures are created below on this thread
+    resourceManager->SetProgressCallback(
+        [](size_t finished, size_t total)
+        { SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "Loaded %zu/%zu images", finished, total); });
+    for (const auto& sheet : BuiltinSheets)
+        resourceManager->LoadTextureAsync(sheet.name, sheet.file);
+    resourceManager->WaitForLoads();
+    // one or two pages instead of a texture per sheet, so batches rarely split
+    if (!resourceManager->BuildAtlas())
+        initSuccess = false;
 
     // intialize input
     this->keys = SDL_GetKeyboardState(nullptr);
@@ -72,10 +135,61 @@ bool Application::Initialize()
     SDL_SetRenderLogicalPresentation(this->renderer, this->logWidth, this->logHeight,
                                      SDL_LOGICAL_PRESENTATION_LETTERBOX);
 
-    SDL_SetRenderVSync(this->renderer, 1);
+    if (config.headless)
+    {
+        // a benchmark runs flat out, it only keeps a rate when --fps asks for one
+        if (this->config.pacing == AppConfig::PacingVsync)
+            this->config.pacing = AppConfig::PacingUncapped;
+    }
+    else if (this->config.pacing == AppConfig::PacingVsync)
+    {
+        if (!SDL_SetRenderVSync(this->renderer, 1))
+        {
+            // software renderers and some drivers cannot wait for the display, so the
+            // limiter holds its refresh rate rather than spinning through frames
+            const SDL_DisplayMode* mode =
+                SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(this->window));
+            this->config.pacing = AppConfig::PacingFixed;
+            this->config.targetFps =
+                mode && mode->refresh_rate > 0.0f ? static_cast<int>(mode->refresh_rate + 0.5f)
+                                                  : 60;
+            SDL_Log("VSync unavailable (%s), pacing at %d fps", SDL_GetError(),
+                    this->config.targetFps);
+        }
+    }
+    else
+    {
+        // the present must not block on top of the limiter
+        SDL_SetRenderVSync(this->renderer, 0);
+    }
+    if (this->config.pacing == AppConfig::PacingFixed)
+        SDL_snprintf(pacingMode, sizeof(pacingMode), "fixed %d fps", this->config.targetFps);
+    else
+        SDL_snprintf(pacingMode, sizeof(pacingMode), "%s",
+                     this->config.pacing == AppConfig::PacingVsync ? "vsync" : "uncapped");
     // intialize level
-    currentLevel = new Level();
-    currentLevel->LoadMap(this->resourceManager);
+    jobSystem = new JobSystem();
+    currentLevel = new Level(*jobSystem, frameArena);
+    currentLevel->SetViewSize(logWidth, logHeight);
+    if (config.stress)
+    {
+        // the scene comes from the same seed as the run, so a capture replays on it too
+        const StressSceneParams& stress = config.stressScene;
+        SDL_Log("Stress scene %ux%u, density %.2f, %u enemies, %.1f shots/s", stress.cols,
+                stress.rows, stress.density, stress.enemies, stress.fireRate);
+        if (!currentLevel->LoadSource(this->resourceManager,
+                                      GenerateStressScene(stress, this->config.seed),
+                                      this->config.seed))
+            return false;
+        currentLevel->SetAutoFire(stress.fireRate);
+    }
+    else if (!currentLevel->LoadMap(this->resourceManager,
+                                    std::string(this->basePath ? this->basePath : "") +
+                                        config.levelPath,
+                                    this->config.seed))
+    {
+        return false;
+    }
 
     return initSuccess;
 }
@@ -83,28 +197,124 @@ bool Application::Initialize()
 void Application::Destroy()
 {
     delete currentLevel;
+    delete jobSystem;
     delete resourceManager;
     SDL_DestroyRenderer(this->renderer);
+    SDL_DestroySurface(this->headlessTarget);
     SDL_DestroyWindow(this->window);
     SDL_Quit();
 }
 
-void Application::Run()
+void Application::BeginFrame(uint64_t frame)
+{
+    frameArena.Reset();
+    if (config.allocCheckWarmup > 0 && frame == static_cast<uint64_t>(config.allocCheckWarmup))
+    {
+        SetHeapAllocationHook(CountLateAllocation);
+        allocCheckArmed = true;
+    }
+}
+
+bool Application::EndAllocationCheck()
+{
+    if (config.allocCheckWarmup == 0)
+        return true;
+    SetHeapAllocationHook(nullptr);
+    if (!allocCheckArmed)
+    {
+        SDL_Log("Allocation check failed: the run ended within %d warm-up frames",
+                config.allocCheckWarmup);
+        return false;
+    }
+    uint64_t count = lateAllocations.load(std::memory_order_relaxed);
+    if (count > 0)
+    {
+        SDL_Log("Allocation check failed: %llu heap allocations after %d warm-up frames",
+                static_cast<unsigned long long>(count), config.allocCheckWarmup);
+        return false;
+    }
+    SDL_Log("Allocation check passed: no heap allocations after %d warm-up frames",
+            config.allocCheckWarmup);
+    return true;
+}
+
+InputState Application::NextTickInput(InputState live)
+{
+    uint64_t tick = simulatedTicks++;
+    if (!config.replayPath.empty())
+        return recording.At(tick);
+    if (!config.recordPath.empty())
+        recording.Record(live);
+    return live;
+}
+
+bool Application::FinishCapture()
 {
+    if (!currentLevel || (config.recordPath.empty() && config.replayPath.empty()))
+        return true;
+
+    uint64_t checksum = currentLevel->ComputeChecksum();
+    if (!config.recordPath.empty())
+        return recording.Save(config.recordPath, checksum);
+
+    if (simulatedTicks < recording.GetTickCount())
+    {
+        SDL_Log("Replay stopped after %llu of %llu ticks, checksum not compared",
+                static_cast<unsigned long long>(simulatedTicks),
+                static_cast<unsigned long long>(recording.GetTickCount()));
+        return true;
+    }
+    if (checksum != recording.GetChecksum())
+    {
+        SDL_Log("Replay diverged: checksum %016llx, the capture ended on %016llx",
+                static_cast<unsigned long long>(checksum),
+                static_cast<unsigned long long>(recording.GetChecksum()));
+        return false;
+    }
+    SDL_Log("Replay matches the capture, checksum %016llx",
+            static_cast<unsigned long long>(checksum));
+    return true;
+}
+
+bool Application::Run()
+{
+    if (config.headless)
+    {
+        RunHeadless();
+        // the hook comes off first, saving a capture allocates
+        bool allocationsPassed = EndAllocationCheck();
+        framePacer.Report(pacingMode);
+        return FinishCapture() && allocationsPassed;
+    }
+
     bool running = true;
-    uint64_t prevTime = SDL_GetTicks();
+    const uint64_t tickNs = SDL_NS_PER_SECOND / config.tickHz;
+    const float tickSeconds = 1.0f / config.tickHz;
+    uint64_t prevTime = SDL_GetTicksNS();
+    uint64_t accumulator = 0;
+    uint64_t frame = 0;
+    framePacer.Start(config.pacing == AppConfig::PacingFixed ? config.targetFps : 0);
 
     while (running)
     {
-        // delta time
-        uint64_t nowTime = SDL_GetTicks();
-        float deltaTime = (nowTime - prevTime) / 1000.0f;
+        PROFILE_ZONE("Frame");
+        BeginFrame(frame++);
+        // frame time
+        uint64_t nowTime = SDL_GetTicksNS();
+        uint64_t frameNs = nowTime - prevTime;
         prevTime = nowTime;
+        uint64_t allocations = GetHeapStats().allocations;
+        perfHud.RecordFrame(frameNs, allocations - frameAllocations);
+        // the first frame has no frame before it to measure
+        if (frame > 1)
+            framePacer.RecordFrame(frameNs);
+        frameAllocations = allocations;
 
         // input polling
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
+            PROFILE_ZONE("Event");
             if (event.type == SDL_EVENT_QUIT)
             {
                 running = false;
@@ -114,6 +324,12 @@ void Application::Run()
                 this->GAME_WIDTH = event.window.data1;
                 this->GAME_HEIGHT = event.window.data2;
             }
+            else if (event.type == SDL_EVENT_RENDER_TARGETS_RESET ||
+                     event.type == SDL_EVENT_RENDER_DEVICE_RESET)
+            {
+                if (currentLevel)
+                    currentLevel->InvalidateRenderCache();
+            }
             else if (keys[SDL_SCANCODE_F3])
             {
                 debugMode = !debugMode;
@@ -121,23 +337,125 @@ void Application::Run()
         }
 
         // game update level
-        if (currentLevel)
+        float alpha = 1.0f;
+        if (currentLevel && config.fixedStep)
+        {
+            PROFILE_ZONE("Simulate");
+            // run whole ticks for the elapsed time, a hitch costs at most maxStepsPerFrame ticks
+            accumulator += frameNs;
+            int steps = 0;
+            while (accumulator >= tickNs && steps < config.maxStepsPerFrame)
+            {
+                currentLevel->Update(tickSeconds, NextTickInput(ReadKeyboard(keys)));
+                accumulator -= tickNs;
+                steps++;
+            }
+            // a replay closes the window once its last tick has run
+            if (!config.replayPath.empty() && simulatedTicks >= recording.GetTickCount())
+                running = false;
+            if (accumulator >= tickNs)
+            {
+                accumulator %= tickNs;
+            }
+            alpha = static_cast<float>(accumulator) / static_cast<float>(tickNs);
+        }
+        else if (currentLevel)
         {
-            currentLevel->Update(deltaTime, keys);
+            currentLevel->Update(frameNs / static_cast<float>(SDL_NS_PER_SECOND),
+                                 ReadKeyboard(keys));
         }
 
-        // render game
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderClear(renderer);
-        SDL_SetRenderDrawColor(renderer, 20, 10, 30, 255);
-        SDL_FRect bgreact = {0, 0, static_cast<float>(logWidth), static_cast<float>(logHeight)};
-        SDL_RenderFillRect(renderer, &bgreact);
+        RenderFrame(alpha);
+        framePacer.Wait();
+    }
+    bool allocationsPassed = EndAllocationCheck();
+    framePacer.Report(pacingMode);
+    return FinishCapture() && allocationsPassed;
+}
+
+void Application::RenderFrame(float alpha)
+{
+    PROFILE_ZONE("RenderFrame");
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 20, 10, 30, 255);
+    SDL_FRect bgreact = {0, 0, static_cast<float>(logWidth), static_cast<float>(logHeight)};
+    SDL_RenderFillRect(renderer, &bgreact);
 
-        if (currentLevel)
-        {
-            currentLevel->Render(renderer, debugMode);
-        }
+    if (currentLevel)
+    {
+        currentLevel->Render(renderer, debugMode, alpha);
+        if (debugMode)
+            perfHud.Draw(renderer, currentLevel->GetStats(), 5.0f,
+                         logHeight - PerfHud::PANEL_HEIGHT - 5.0f, 1000.0f / config.tickHz,
+                         pacingMode);
+    }
 
-        SDL_RenderPresent(renderer);
+    PROFILE_ZONE("Present");
+    SDL_RenderPresent(renderer);
+}
+
+void Application::RunHeadless()
+{
+    if (!currentLevel)
+        return;
+
+    // every tick is simulated and rendered once, input comes from the script
+    const float tickSeconds = 1.0f / config.tickHz;
+    uint64_t updateNs = 0, collisionNs = 0, groundNs = 0, renderNs = 0;
+    uint64_t pairsTested = 0;
+    uint64_t drawCalls = 0, spriteQuads = 0;
+    uint64_t activeChunks = 0, residentChunks = 0;
+
+    framePacer.Start(config.pacing == AppConfig::PacingFixed ? config.targetFps : 0);
+    uint64_t startTime = SDL_GetTicksNS();
+    uint64_t frameStart = startTime;
+    for (uint64_t tick = 0; tick < config.benchTicks; tick++)
+    {
+        PROFILE_ZONE("Tick");
+        BeginFrame(tick);
+        currentLevel->Update(tickSeconds, NextTickInput(inputScript.At(tick)));
+        RenderFrame(1.0f);
+        framePacer.Wait();
+        uint64_t frameEnd = SDL_GetTicksNS();
+        framePacer.RecordFrame(frameEnd - frameStart);
+        frameStart = frameEnd;
+
+        const LevelStats& stats = currentLevel->GetStats();
+        updateNs += stats.updateNs;
+        collisionNs += stats.collisionNs;
+        groundNs += stats.groundNs;
+        renderNs += stats.renderNs;
+        pairsTested += stats.pairsTested;
+        drawCalls += stats.drawCalls;
+        spriteQuads += stats.spriteQuads;
+        activeChunks += stats.activeChunks;
+        residentChunks += stats.residentChunks;
+    }
+    uint64_t totalNs = SDL_GetTicksNS() - startTime;
+
+    const double ticks = static_cast<double>(config.benchTicks);
+    std::printf("headless: %llu ticks at %d Hz in %.2f ms, %.1f ticks/s\n",
+                static_cast<unsigned long long>(config.benchTicks), config.tickHz, totalNs / 1e6,
+                ticks / (totalNs / 1e9));
+    std::printf("%-10s %12s %12s\n", "phase", "total ms", "avg us/tick");
+    const struct
+    {
+        const char* name;
+        uint64_t ns;
+    } phases[] = {{"update", updateNs},
+                  {"collision", collisionNs},
+                  {"ground", groundNs},
+                  {"render", renderNs}};
+    for (const auto& phase : phases)
+    {
+        std::printf("%-10s %12.3f %12.3f\n", phase.name, phase.ns / 1e6, phase.ns / 1e3 / ticks);
     }
+    std::printf("pairs tested: %.2f per tick\n", pairsTested / ticks);
+    std::printf("draw calls: %.2f per frame, quads: %.2f per frame\n", drawCalls / ticks,
+                spriteQuads / ticks);
+    std::printf("chunks: %.2f active, %.2f resident per tick\n", activeChunks / ticks,
+                residentChunks / ticks);
+    std::printf("checksum: %016llx\n",
+                static_cast<unsigned long long>(currentLevel->ComputeChecksum()));
 }
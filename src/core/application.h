@@ -2,7 +2,13 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_video.h>
 
+#include "appConfig.h"
+#include "frameArena.h"
+#include "framePacer.h"
+#include "inputRecording.h"
+#include "inputScript.h"
 #include "game/Level.h"
+#include "perfHud.h"
 #include "resourceManager.h"
 
 class Application
@@ -10,18 +16,47 @@ class Application
    private:
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
+    // software render target used instead of a window in headless mode
+    SDL_Surface* headlessTarget = nullptr;
     const bool* keys = nullptr;
     const char* basePath = nullptr;
     ResourceManager* resourceManager = nullptr;
+    JobSystem* jobSystem = nullptr;
+    // per-frame scratch memory, reset at the top of every frame
+    FrameArena frameArena;
     Level* currentLevel = nullptr;
     int GAME_WIDTH = 1600;
     int GAME_HEIGHT = 900;
     const int logWidth = 640;
     const int logHeight = 320;
     bool debugMode = false;
+    AppConfig config;
+    InputScript inputScript;
+    // the capture being written (--record) or played back (--replay)
+    InputRecording recording;
+    uint64_t simulatedTicks = 0;
+    PerfHud perfHud;
+    // waits out the frame in fixed pacing, measures the jitter in every mode
+    FramePacer framePacer;
+    // "vsync", "uncapped" or "fixed N fps", for the HUD and the report
+    char pacingMode[24] = "";
+    // heap allocation total at the start of the current frame
+    uint64_t frameAllocations = 0;
+    bool allocCheckArmed = false;
+
+    void RenderFrame(float alpha);
+    void RunHeadless();
+    // --check-alloc: from frame (or tick) number allocCheckWarmup on, allocations fail
+    void BeginFrame(uint64_t frame);
+    bool EndAllocationCheck();
+    // input for the next tick: live as it is, recorded on the way, or from the replay
+    InputState NextTickInput(InputState live);
+    // saves the capture, or checks the replay ended where the capture did
+    bool FinishCapture();
 
    public:
-    bool Initialize();
+    bool Initialize(const AppConfig& config);
     void Destroy();
-    void Run();
+    // false when the allocation test failed
+    bool Run();
 };
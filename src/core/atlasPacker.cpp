@@ -0,0 +1,79 @@
+#include "atlasPacker.h"
+
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(int width, int height) : pageWidth(width), pageHeight(height)
+{
+    skyline.push_back({0, 0, width});
+}
+
+int SkylinePacker::Fit(size_t i, int w, int h) const
+{
+    int x = skyline[i].x;
+    if (x + w > pageWidth)
+        return -1;
+
+    // the rect rests on the highest segment it spans
+    int y = 0;
+    int remaining = w;
+    for (size_t j = i; remaining > 0; j++)
+    {
+        if (j >= skyline.size())
+            return -1;
+        y = std::max(y, skyline[j].y);
+        remaining -= skyline[j].width;
+    }
+    return y + h <= pageHeight ? y : -1;
+}
+
+bool SkylinePacker::Insert(int w, int h, SDL_Point& position)
+{
+    // lowest resulting top edge wins, scanning left to right keeps the leftmost on ties
+    size_t best = skyline.size();
+    int bestBottom = pageHeight + 1;
+    for (size_t i = 0; i < skyline.size(); i++)
+    {
+        int y = Fit(i, w, h);
+        if (y >= 0 && y + h < bestBottom)
+        {
+            best = i;
+            bestBottom = y + h;
+        }
+    }
+    if (best == skyline.size())
+        return false;
+
+    position = {skyline[best].x, bestBottom - h};
+    skyline.insert(skyline.begin() + best, {position.x, bestBottom, w});
+
+    // trim or drop the segments the new one now covers
+    for (size_t i = best + 1; i < skyline.size();)
+    {
+        int coveredEnd = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= coveredEnd)
+            break;
+        int shrink = coveredEnd - skyline[i].x;
+        if (shrink < skyline[i].width)
+        {
+            skyline[i].x += shrink;
+            skyline[i].width -= shrink;
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <vector>
+
+// an image packed into an atlas page: the page texture and the image's pixel rect on it
+struct AtlasRegion
+{
+    SDL_Texture* texture = nullptr;
+    SDL_FRect rect = {0, 0, 0, 0};
+};
+
+// Skyline bottom-left packer for one atlas page. The skyline is the top edge of
+// everything placed so far; each rect goes where it ends lowest, leftmost on ties.
+class SkylinePacker
+{
+    struct Segment
+    {
+        int x, y, width;
+    };
+
+    int pageWidth;
+    int pageHeight;
+    std::vector<Segment> skyline;
+
+    // y a w-wide rect would rest at when placed on segment i, -1 if it does not fit
+    int Fit(size_t i, int w, int h) const;
+
+   public:
+    SkylinePacker(int width, int height);
+
+    // finds room for a w x h rect, returns false when the page is full
+    bool Insert(int w, int h, SDL_Point& position);
+};
@@ -3,13 +3,23 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_rect.h>
 
+#include <cstdint>
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
 
+// sprites kept and dropped by the visibility test in one frame
+struct CullStats
+{
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+};
+
 class Camera
 {
    private:
     SDL_FRect viewport;
+    // viewport position from the previous Follow, for render interpolation
+    SDL_FPoint prevPosition{0, 0};
     int mapW, mapH;
 
    public:
@@ -20,6 +30,7 @@ class Camera
 
     void Follow(glm::vec2 target_position)
     {
+        prevPosition = {viewport.x, viewport.y};
         viewport.x = target_position.x - (viewport.w / 2);
         viewport.y = target_position.y - (viewport.h / 2);
         if (mapH > 0 && mapW > 0)
@@ -34,5 +45,38 @@ class Camera
                 viewport.y = mapH - viewport.h;
         }
     }
+    // keeps the view centred where it is, the next Follow clamps it to the map
+    void SetSize(float width, float height)
+    {
+        viewport.x += (viewport.w - width) / 2;
+        viewport.y += (viewport.h - height) / 2;
+        viewport.w = width;
+        viewport.h = height;
+    }
+    // drop the interpolation history, e.g. after placing the camera on a new level
+    void ResetInterpolation() { prevPosition = {viewport.x, viewport.y}; }
     glm::vec2 GetOffset() const { return {-viewport.x, -viewport.y}; }
+    // world-space rect on screen at the same alpha as GetOffset(alpha)
+    SDL_FRect GetVisibleRect(float alpha) const
+    {
+        glm::vec2 offset = GetOffset(alpha);
+        return {-offset.x, -offset.y, viewport.w, viewport.h};
+    }
+    // true when a world-space rect shows on screen, rects only touching the edge do not
+    bool IsVisible(const SDL_FRect& rect, float alpha) const
+    {
+        return IsVisible(GetVisibleRect(alpha), rect);
+    }
+    // same test against a view from GetVisibleRect, for loops that fetch it once
+    static bool IsVisible(const SDL_FRect& view, const SDL_FRect& rect)
+    {
+        return rect.x < view.x + view.w && rect.x + rect.w > view.x &&
+               rect.y < view.y + view.h && rect.y + rect.h > view.y;
+    }
+    // offset blended between the last two Follow calls, alpha in [0, 1]
+    glm::vec2 GetOffset(float alpha) const
+    {
+        return {-(prevPosition.x + (viewport.x - prevPosition.x) * alpha),
+                -(prevPosition.y + (viewport.y - prevPosition.y) * alpha)};
+    }
 };
@@ -0,0 +1,42 @@
+#include "frameArena.h"
+
+#include <algorithm>
+
+FrameArena::FrameArena(size_t capacity)
+    : block(std::make_unique_for_overwrite<unsigned char[]>(capacity)), capacity(capacity)
+{
+}
+
+void* FrameArena::Allocate(size_t size, size_t align)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    size_t offset = ((base + used + align - 1) & ~(uintptr_t(align) - 1)) - base;
+    if (offset + size <= capacity)
+    {
+        used = offset + size;
+        peak = std::max(peak, used + spilledBytes);
+        return block.get() + offset;
+    }
+
+    // over budget this frame, take it from the heap and fix the block size on Reset
+    size_t bytes = size + align;
+    spills.push_back(std::make_unique_for_overwrite<unsigned char[]>(bytes));
+    spilledBytes += bytes;
+    peak = std::max(peak, used + spilledBytes);
+    uintptr_t spill = reinterpret_cast<uintptr_t>(spills.back().get());
+    return reinterpret_cast<void*>((spill + align - 1) & ~(uintptr_t(align) - 1));
+}
+
+void FrameArena::Reset()
+{
+    if (!spills.empty())
+    {
+        spills.clear();
+        spilledBytes = 0;
+        // half again the peak, so a frame that is slightly busier does not spill again
+        capacity = std::max(capacity, peak + peak / 2);
+        block = std::make_unique_for_overwrite<unsigned char[]>(capacity);
+    }
+    used = 0;
+    peak = 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for data that only lives until the end of the frame. Allocate moves a
+// cursor through one block and Reset rewinds it once per frame; nothing is freed on its
+// own and no destructors run, so only trivially destructible data belongs here.
+// A frame that outgrows the block spills into heap blocks, Reset frees them and grows
+// the block to the peak, so after a few frames of warm-up the arena stops using the heap.
+// Not thread-safe: the main thread owns it, jobs get plain pointers into it.
+class FrameArena
+{
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity = 0;
+    size_t used = 0;
+    // requests the block could not hold, freed by the next Reset
+    std::vector<std::unique_ptr<unsigned char[]>> spills;
+    size_t spilledBytes = 0;
+    // most this frame needed at once, what the block grows to when it spilled
+    size_t peak = 0;
+
+    friend class ScratchScope;
+
+   public:
+    explicit FrameArena(size_t capacity = 256 * 1024);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // align must be a power of two, the memory is uninitialized
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+    template <typename T>
+    T* AllocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    // start of a frame: everything handed out before is dead
+    void Reset();
+
+    size_t GetUsed() const { return used + spilledBytes; }
+    size_t GetCapacity() const { return capacity; }
+};
+
+// Rewinds the arena to where it was when the scope opened, so one pass can borrow
+// scratch memory and return it before the frame ends. Scopes nest; whatever was
+// allocated inside must be dead when the scope closes.
+class ScratchScope
+{
+    FrameArena& arena;
+    size_t mark;
+
+   public:
+    explicit ScratchScope(FrameArena& arena) : arena(arena), mark(arena.used) {}
+    ~ScratchScope() { arena.used = mark; }
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+};
+
+// lets standard containers grow in the arena, freeing is a no-op until the next Reset
+template <typename T>
+struct ArenaAllocator
+{
+    using value_type = T;
+    FrameArena* arena;
+
+    explicit ArenaAllocator(FrameArena& arena) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t count) { return arena->AllocateArray<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return arena == other.arena;
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return arena != other.arena;
+    }
+};
+
+// scratch list for one pass, reserve up front since every regrowth leaves the old buffer
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,85 @@
+#include "framePacer.h"
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_timer.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "profiler.h"
+
+// spin at least this long before a deadline, at most this long whatever the host does
+static const uint64_t MIN_SPIN_NS = 100 * 1000;
+static const uint64_t MAX_SPIN_NS = 2 * SDL_NS_PER_MS;
+
+void FramePacer::Start(int targetFps)
+{
+    periodNs = targetFps > 0 ? SDL_NS_PER_SECOND / static_cast<uint64_t>(targetFps) : 0;
+    startNs = SDL_GetTicksNS();
+    deadline = startNs + periodNs;
+    spinMarginNs = SDL_NS_PER_MS;
+}
+
+void FramePacer::Wait()
+{
+    if (periodNs == 0)
+        return;
+
+    PROFILE_ZONE("FramePacer::Wait");
+    uint64_t now = SDL_GetTicksNS();
+    if (now >= deadline)
+    {
+        lateFrames++;
+        deadline = now + periodNs;
+        return;
+    }
+
+    if (deadline - now > spinMarginNs)
+    {
+        const uint64_t wakeAt = deadline - spinMarginNs;
+        SDL_DelayPrecise(wakeAt - now);
+        uint64_t woke = SDL_GetTicksNS();
+        sleptNs += woke - now;
+        // a late wake widens the margin at once, it narrows again by 1/64 a frame
+        uint64_t overslept = woke > wakeAt ? woke - wakeAt : 0;
+        spinMarginNs = std::max(spinMarginNs - spinMarginNs / 64, overslept + MIN_SPIN_NS);
+        spinMarginNs = std::clamp(spinMarginNs, MIN_SPIN_NS, MAX_SPIN_NS);
+        now = woke;
+    }
+
+    const uint64_t spinStart = now;
+    while (now < deadline)
+    {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetTicksNS();
+    }
+    spunNs += now - spinStart;
+    deadline += periodNs;
+}
+
+void FramePacer::RecordFrame(uint64_t frameNs)
+{
+    frames++;
+    const double ns = static_cast<double>(frameNs);
+    const double delta = ns - meanNs;
+    meanNs += delta / static_cast<double>(frames);
+    squaredNs += delta * (ns - meanNs);
+    worstNs = std::max(worstNs, frameNs);
+}
+
+void FramePacer::Report(const char* mode) const
+{
+    if (frames == 0)
+        return;
+
+    const double jitterNs =
+        frames > 1 ? std::sqrt(squaredNs / static_cast<double>(frames - 1)) : 0.0;
+    const double totalNs = static_cast<double>(SDL_GetTicksNS() - startNs);
+    SDL_Log("Pacing %s: %llu frames, mean %.3f ms, jitter %.3f ms, worst %.3f ms, "
+            "%llu late, %.1f%% slept, %.1f%% spun",
+            mode, static_cast<unsigned long long>(frames), meanNs / 1e6, jitterNs / 1e6,
+            worstNs / 1e6, static_cast<unsigned long long>(lateFrames),
+            100.0 * static_cast<double>(sleptNs) / totalNs,
+            100.0 * static_cast<double>(spunNs) / totalNs);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// Holds the main loop at a fixed frame rate without keeping a core busy: Wait sleeps with
+// SDL_DelayPrecise until spinMarginNs before the deadline and spins the rest on the clock.
+// The margin follows the worst recent oversleep, so a host that wakes late spins a little
+// longer and a precise one barely spins at all. Deadlines advance by whole periods; a
+// frame that misses its deadline starts the next one at once instead of rushing to win
+// the time back.
+// Every frame is also measured, paced or not, and Report prints the jitter of the run.
+// Nothing here allocates, the frame loop stays clean for --check-alloc.
+class FramePacer
+{
+    // 0 never waits, frames are only measured
+    uint64_t periodNs = 0;
+    uint64_t deadline = 0;
+    uint64_t spinMarginNs = 0;
+    uint64_t startNs = 0;
+
+    // running mean and squared deviations of the frame time (Welford)
+    uint64_t frames = 0;
+    double meanNs = 0.0;
+    double squaredNs = 0.0;
+    uint64_t worstNs = 0;
+    uint64_t lateFrames = 0;
+    uint64_t sleptNs = 0;
+    uint64_t spunNs = 0;
+
+   public:
+    // targetFps 0 leaves the pace to the present (vsync) or to nothing (uncapped)
+    void Start(int targetFps);
+    // blocks until the next frame is due, call once per frame after the present
+    void Wait();
+    // frameNs is the whole frame that just ended, the wait included
+    void RecordFrame(uint64_t frameNs);
+    // one line: mean frame time, jitter as its standard deviation, the worst frame,
+    // missed deadlines and how much of the time since Start was slept and spun
+    void Report(const char* mode) const;
+};
@@ -0,0 +1,77 @@
+#include "heapStats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> freeCount{0};
+static std::atomic<HeapAllocationHook> allocationHook{nullptr};
+
+HeapStats GetHeapStats()
+{
+    return {allocationCount.load(std::memory_order_relaxed),
+            freeCount.load(std::memory_order_relaxed)};
+}
+
+void SetHeapAllocationHook(HeapAllocationHook hook) { allocationHook.store(hook); }
+
+static void CountAllocation(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (HeapAllocationHook hook = allocationHook.load(std::memory_order_relaxed))
+        hook(size);
+}
+
+// The standard library routes the array and nothrow forms through the ones below, so
+// these are enough to see every allocation.
+void* operator new(std::size_t size)
+{
+    CountAllocation(size);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    CountAllocation(size);
+    std::size_t alignment = static_cast<std::size_t>(align);
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(size ? size : 1, alignment);
+#else
+    // aligned_alloc wants a non-zero multiple of the alignment
+    std::size_t bytes = size ? (size + alignment - 1) / alignment * alignment : alignment;
+    void* ptr = std::aligned_alloc(alignment, bytes);
+#endif
+    if (ptr)
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    if (!ptr)
+        return;
+    freeCount.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t align) noexcept
+{
+    operator delete(ptr, align);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Running totals of the global operator new / delete, which heapStats.cpp replaces.
+// Only C++ allocations are seen, SDL's own malloc calls are not.
+struct HeapStats
+{
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+};
+
+// totals over every thread since startup, the HUD shows the difference per frame
+HeapStats GetHeapStats();
+
+// Called from operator new with the size of every allocation while installed, on the
+// allocating thread. It must not allocate itself. nullptr removes it.
+using HeapAllocationHook = void (*)(std::size_t size);
+void SetHeapAllocationHook(HeapAllocationHook hook);
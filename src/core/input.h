@@ -0,0 +1,34 @@
+#pragma once
+#include <SDL3/SDL_scancode.h>
+
+#include <cstdint>
+
+// Gameplay buttons for one tick. Decoupled from SDL_GetKeyboardState so the
+// simulation can also be driven by scripts and recordings.
+struct InputState
+{
+    enum Button : uint8_t
+    {
+        Left = 1 << 0,
+        Right = 1 << 1,
+        Jump = 1 << 2,
+        Fire = 1 << 3,
+    };
+    uint8_t buttons = 0;
+
+    bool IsDown(Button button) const { return (buttons & button) != 0; }
+};
+
+inline InputState ReadKeyboard(const bool* keys)
+{
+    InputState input;
+    if (keys[SDL_SCANCODE_A])
+        input.buttons |= InputState::Left;
+    if (keys[SDL_SCANCODE_D])
+        input.buttons |= InputState::Right;
+    if (keys[SDL_SCANCODE_SPACE])
+        input.buttons |= InputState::Jump;
+    if (keys[SDL_SCANCODE_E])
+        input.buttons |= InputState::Fire;
+    return input;
+}
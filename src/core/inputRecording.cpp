@@ -0,0 +1,136 @@
+#include "inputRecording.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "appConfig.h"
+
+// runs of a few minutes of play, so recording does not allocate while the game runs
+static const size_t RUN_RESERVE = 4096;
+
+void InputRecording::Begin(int tickHz, uint64_t seed)
+{
+    runs.clear();
+    runs.reserve(RUN_RESERVE);
+    header = {};
+    std::memcpy(header.magic, "GINP", 4);
+    header.version = INPUT_RECORDING_VERSION;
+    header.tickHz = static_cast<uint32_t>(tickHz);
+    header.seed = seed;
+}
+
+void InputRecording::Record(InputState input)
+{
+    if (runs.empty() || runs.back().input.buttons != input.buttons)
+        runs.push_back({header.tickCount, input});
+    header.tickCount++;
+}
+
+bool InputRecording::Save(const std::string& path, uint64_t checksum)
+{
+    header.runCount = static_cast<uint32_t>(runs.size());
+    header.checksum = checksum;
+
+    std::vector<uint8_t> stream;
+    uint8_t previous = 0;
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        uint64_t end = r + 1 < runs.size() ? runs[r + 1].start : header.tickCount;
+        uint64_t ticks = end - runs[r].start;
+        do
+        {
+            uint8_t byte = ticks & 0x7F;
+            ticks >>= 7;
+            stream.push_back(ticks ? byte | 0x80 : byte);
+        } while (ticks);
+        stream.push_back(runs[r].input.buttons ^ previous);
+        previous = runs[r].input.buttons;
+    }
+
+    std::ofstream target(path, std::ios::binary | std::ios::trunc);
+    target.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    target.write(reinterpret_cast<const char*>(stream.data()),
+                 static_cast<std::streamsize>(stream.size()));
+    if (!target)
+    {
+        SDL_Log("Cannot write %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool InputRecording::Load(const std::string& path)
+{
+    std::ifstream source(path, std::ios::binary);
+    if (!source)
+    {
+        SDL_Log("Cannot read %s", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(source)),
+                              std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(header))
+    {
+        SDL_Log("Input recording %s is truncated", path.c_str());
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    // the tick rate replaces --tick-hz and gets the same bounds; every run takes at least
+    // a tick count byte and a buttons byte
+    if (std::memcmp(header.magic, "GINP", 4) != 0 || header.version != INPUT_RECORDING_VERSION ||
+        header.tickHz == 0 || header.tickHz > static_cast<uint32_t>(MAX_TICK_HZ) ||
+        header.runCount > (data.size() - sizeof(header)) / 2)
+    {
+        SDL_Log("Input recording %s has a bad header", path.c_str());
+        return false;
+    }
+
+    runs.clear();
+    runs.reserve(header.runCount);
+    size_t pos = sizeof(header);
+    uint64_t tick = 0;
+    uint8_t buttons = 0;
+    while (pos < data.size())
+    {
+        uint64_t ticks = 0;
+        int shift = 0;
+        uint8_t byte = 0x80;
+        while ((byte & 0x80) && pos < data.size() && shift < 64)
+        {
+            byte = data[pos++];
+            ticks |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        }
+        if ((byte & 0x80) || ticks == 0 || pos == data.size())
+        {
+            SDL_Log("Input recording %s has a broken run at tick %llu", path.c_str(),
+                    static_cast<unsigned long long>(tick));
+            return false;
+        }
+        buttons ^= data[pos++];
+        runs.push_back({tick, {buttons}});
+        tick += ticks;
+    }
+    if (runs.size() != header.runCount || tick != header.tickCount)
+    {
+        SDL_Log("Input recording %s holds %llu ticks, its header says %llu", path.c_str(),
+                static_cast<unsigned long long>(tick),
+                static_cast<unsigned long long>(header.tickCount));
+        return false;
+    }
+    return true;
+}
+
+InputState InputRecording::At(uint64_t tick) const
+{
+    if (tick >= header.tickCount)
+        return {};
+    // the last run starting at or before tick
+    auto next = std::upper_bound(runs.begin(), runs.end(), tick,
+                                 [](uint64_t t, const Run& run) { return t < run.start; });
+    return std::prev(next)->input;
+}
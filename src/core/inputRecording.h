@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "input.h"
+
+// On-disk capture layout, version 1. Little-endian, the header is written as it is
+// in memory and followed by the input stream: one entry per run of identical ticks,
+// a LEB128 tick count and then the buttons XORed with those of the run before. A
+// held key costs nothing per tick, so a minute of play is usually under a kilobyte.
+struct InputRecordingHeader
+{
+    char magic[4];  // "GINP"
+    uint32_t version;
+    uint32_t tickHz;
+    uint32_t runCount;
+    uint64_t seed;       // level RNG seed the run started from
+    uint64_t tickCount;  // ticks covered by the runs
+    uint64_t checksum;   // Level::ComputeChecksum after the last tick
+};
+
+static_assert(sizeof(InputRecordingHeader) == 40);
+
+inline constexpr uint32_t INPUT_RECORDING_VERSION = 1;
+
+// The buttons of every tick of a fixed-step run, so the run can be fed into
+// Level::Update again tick for tick. Runs of equal input are kept as they are on
+// disk, a lookup is a binary search over their start ticks.
+class InputRecording
+{
+    struct Run
+    {
+        uint64_t start;  // first tick of the run
+        InputState input;
+    };
+    std::vector<Run> runs;
+    InputRecordingHeader header{};
+
+   public:
+    // starts an empty recording for a run at tickHz seeded with seed
+    void Begin(int tickHz, uint64_t seed);
+    // appends the input of the next tick
+    void Record(InputState input);
+    // writes the recording with the final state checksum, false (with an SDL_Log) on failure
+    bool Save(const std::string& path, uint64_t checksum);
+    // false (with an SDL_Log) if missing or malformed
+    bool Load(const std::string& path);
+
+    // input of a tick, ticks past the end press nothing
+    InputState At(uint64_t tick) const;
+    uint64_t GetTickCount() const { return header.tickCount; }
+    int GetTickHz() const { return static_cast<int>(header.tickHz); }
+    uint64_t GetSeed() const { return header.seed; }
+    uint64_t GetChecksum() const { return header.checksum; }
+};
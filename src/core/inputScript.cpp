@@ -0,0 +1,74 @@
+#include "inputScript.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <cstdlib>
+
+// shoot the two patrolling enemies, then run and jump back and forth left of the gap
+const char* InputScript::DefaultScript = "240:F,150:RF,12:RJ,30:,150:LF,12:LJ,30:,60:J";
+
+bool InputScript::Parse(const std::string& text)
+{
+    segments.clear();
+    totalTicks = 0;
+
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos)
+            end = text.size();
+        std::string item = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        size_t colon = item.find(':');
+        char* numEnd = nullptr;
+        long ticks = std::strtol(item.c_str(), &numEnd, 10);
+        if (colon == std::string::npos || numEnd != item.c_str() + colon || ticks <= 0)
+        {
+            SDL_Log("Invalid input script segment: %s", item.c_str());
+            return false;
+        }
+
+        Segment segment{static_cast<uint32_t>(ticks), {}};
+        for (size_t i = colon + 1; i < item.size(); i++)
+        {
+            switch (item[i])
+            {
+                case 'L':
+                    segment.input.buttons |= InputState::Left;
+                    break;
+                case 'R':
+                    segment.input.buttons |= InputState::Right;
+                    break;
+                case 'J':
+                    segment.input.buttons |= InputState::Jump;
+                    break;
+                case 'F':
+                    segment.input.buttons |= InputState::Fire;
+                    break;
+                default:
+                    SDL_Log("Invalid input script button '%c' in: %s", item[i], item.c_str());
+                    return false;
+            }
+        }
+        segments.push_back(segment);
+        totalTicks += segment.ticks;
+    }
+    return !segments.empty();
+}
+
+InputState InputScript::At(uint64_t tick) const
+{
+    if (segments.empty())
+        return {};
+
+    uint64_t t = tick % totalTicks;
+    for (const Segment& segment : segments)
+    {
+        if (t < segment.ticks)
+            return segment.input;
+        t -= segment.ticks;
+    }
+    return {};
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "input.h"
+
+// Looping list of (ticks, buttons) segments used in place of the keyboard for
+// headless runs. Text form is "ticks:buttons,..." with buttons from L R J F,
+// e.g. "120:R,10:RJ,60:RF" runs right, jumps, then fires while running.
+class InputScript
+{
+    struct Segment
+    {
+        uint32_t ticks;
+        InputState input;
+    };
+    std::vector<Segment> segments;
+    uint64_t totalTicks = 0;
+
+   public:
+    static const char* DefaultScript;
+
+    bool Parse(const std::string& text);
+    InputState At(uint64_t tick) const;
+};
@@ -0,0 +1,185 @@
+#include "jobSystem.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#include "profiler.h"
+
+namespace
+{
+// which system's deque the calling thread owns, workers set this once at startup
+thread_local const JobSystem* queueOwner = nullptr;
+thread_local uint32_t ownQueue = 0;
+}  // namespace
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    if (workerCount == 0)
+        workerCount = static_cast<unsigned>(std::max(SDL_GetNumLogicalCPUCores() - 1, 1));
+
+    jobs = std::make_unique<Job[]>(MAX_JOBS);
+    // a range has one join waiting on it, a chained job one successor; reserving that up
+    // front keeps Depend off the heap
+    for (uint32_t i = 0; i < MAX_JOBS; i++)
+        jobs[i].dependents.reserve(2);
+    freeJobs.reserve(MAX_JOBS);
+    for (uint32_t i = MAX_JOBS; i > 0; i--)
+        freeJobs.push_back(i - 1);
+
+    // deque 0 is shared by every thread that is not a worker
+    queueCount = workerCount + 1;
+    queues = std::make_unique<WorkQueue[]>(queueCount);
+    for (uint32_t q = 0; q < queueCount; q++)
+        queues[q].ring = std::make_unique<uint32_t[]>(MAX_JOBS);
+
+    workers.reserve(workerCount);
+    for (uint32_t q = 1; q < queueCount; q++)
+        workers.emplace_back([this, q]() { WorkerLoop(q); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+uint32_t JobSystem::QueueOfThisThread() const { return queueOwner == this ? ownQueue : 0; }
+
+void JobSystem::WorkerLoop(uint32_t queue)
+{
+    PROFILE_THREAD("JobSystem worker");
+    queueOwner = this;
+    ownQueue = queue;
+    for (;;)
+    {
+        if (TryRunOne(queue))
+            continue;
+
+        std::unique_lock<std::mutex> lock(wakeLock);
+        wake.wait(lock, [this]() { return stopping || queuedJobs.load() > 0; });
+        if (stopping && queuedJobs.load() == 0)
+            return;
+    }
+}
+
+bool JobSystem::TryRunOne(uint32_t queue)
+{
+    uint32_t index = 0;
+    bool found = false;
+    {
+        // own work first, newest job on top is the one whose data is still in cache
+        WorkQueue& own = queues[queue];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (own.head != own.tail)
+        {
+            index = own.ring[--own.tail % MAX_JOBS];
+            found = true;
+        }
+    }
+    for (uint32_t i = 1; i < queueCount && !found; i++)
+    {
+        // then steal the oldest job of the next busy queue
+        WorkQueue& victim = queues[(queue + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        if (victim.head != victim.tail)
+        {
+            index = victim.ring[victim.head++ % MAX_JOBS];
+            found = true;
+        }
+    }
+    if (!found)
+        return false;
+
+    queuedJobs.fetch_sub(1);
+    Job& job = jobs[index];
+    job.invoke(job.storage);
+    Finish(index);
+    return true;
+}
+
+void JobSystem::Enqueue(uint32_t index)
+{
+    WorkQueue& queue = queues[QueueOfThisThread()];
+    {
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.ring[queue.tail++ % MAX_JOBS] = index;
+    }
+    queuedJobs.fetch_add(1);
+    {
+        // taking the lock orders this against a worker that is about to sleep
+        std::lock_guard<std::mutex> lock(wakeLock);
+    }
+    wake.notify_one();
+}
+
+void JobSystem::Finish(uint32_t index)
+{
+    Job& job = jobs[index];
+    job.destroy(job.storage);
+    {
+        std::lock_guard<std::mutex> lock(job.lock);
+        // handles of this run now read as done, and Depend stops adding to dependents
+        uint32_t next = job.generation.load(std::memory_order_relaxed) + 1;
+        job.generation.store(next != 0 ? next : 1, std::memory_order_release);
+    }
+    for (uint32_t dependent : job.dependents)
+    {
+        if (jobs[dependent].unmetDependencies.fetch_sub(1) == 1)
+            Enqueue(dependent);
+    }
+    job.dependents.clear();
+
+    std::lock_guard<std::mutex> lock(freeLock);
+    freeJobs.push_back(index);
+}
+
+uint32_t JobSystem::AllocateJob()
+{
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(freeLock);
+            if (!freeJobs.empty())
+            {
+                uint32_t index = freeJobs.back();
+                freeJobs.pop_back();
+                return index;
+            }
+        }
+        // every slot is in flight, help drain them
+        if (!TryRunOne(QueueOfThisThread()))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::Depend(JobHandle job, JobHandle on)
+{
+    if (on.generation == 0)
+        return;
+    Job& dependency = jobs[on.index];
+    std::lock_guard<std::mutex> lock(dependency.lock);
+    if (dependency.generation.load(std::memory_order_relaxed) != on.generation)
+        return;
+    jobs[job.index].unmetDependencies.fetch_add(1);
+    dependency.dependents.push_back(job.index);
+}
+
+void JobSystem::Release(JobHandle job)
+{
+    if (jobs[job.index].unmetDependencies.fetch_sub(1) == 1)
+        Enqueue(job.index);
+}
+
+void JobSystem::Wait(JobHandle job)
+{
+    const uint32_t queue = QueueOfThisThread();
+    while (!IsDone(job))
+    {
+        if (!TryRunOne(queue))
+            std::this_thread::yield();
+    }
+}
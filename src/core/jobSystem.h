@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A scheduled job. It is done once it ran, which the slot generation moving on tells;
+// a default handle is always done.
+struct JobHandle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;
+};
+
+// Work-stealing scheduler for short, CPU-bound jobs. Every worker owns a deque and works
+// LIFO on its own end, idle workers steal FIFO from the other end of someone else's.
+// Threads that are not workers (the main thread) share deque 0 and run jobs while they
+// Wait, so blocking on a handle never idles a core. A job can depend on others and
+// is queued once they are all done. Jobs live in a fixed pool and keep their callable
+// inline, so scheduling does not allocate once the pool is warm.
+// Long blocking work such as file IO belongs on a ThreadPool instead.
+class JobSystem
+{
+   public:
+    static const uint32_t MAX_JOBS = 4096;
+    // bytes of captures a job keeps inline, capture big state by reference
+    static const size_t JOB_STORAGE = 64;
+
+   private:
+    struct Job
+    {
+        alignas(std::max_align_t) unsigned char storage[JOB_STORAGE];
+        void (*invoke)(void*) = nullptr;
+        void (*destroy)(void*) = nullptr;
+        // bumped when the job finishes, handles of earlier runs of the slot are done
+        std::atomic<uint32_t> generation{1};
+        // dependencies still running, plus one while the creator holds the job back
+        std::atomic<uint32_t> unmetDependencies{0};
+        std::mutex lock;
+        // jobs waiting on this one, guarded by lock until the generation moves on
+        std::vector<uint32_t> dependents;
+    };
+    // ring of job indices, it cannot overflow with no more than MAX_JOBS jobs alive
+    struct WorkQueue
+    {
+        std::mutex lock;
+        std::unique_ptr<uint32_t[]> ring;
+        uint32_t head = 0;  // steal end
+        uint32_t tail = 0;  // owner end
+    };
+
+    std::unique_ptr<Job[]> jobs;
+    std::vector<uint32_t> freeJobs;
+    std::mutex freeLock;
+    std::unique_ptr<WorkQueue[]> queues;
+    uint32_t queueCount = 0;
+    std::vector<std::thread> workers;
+    std::atomic<uint32_t> queuedJobs{0};
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    uint32_t QueueOfThisThread() const;
+    void WorkerLoop(uint32_t queue);
+    bool TryRunOne(uint32_t queue);
+    void Enqueue(uint32_t index);
+    void Finish(uint32_t index);
+    uint32_t AllocateJob();
+
+    // a held job runs only after Release, Depend may be called on it until then
+    template <typename Fn>
+    JobHandle Create(Fn&& fn)
+    {
+        using Callable = std::decay_t<Fn>;
+        static_assert(sizeof(Callable) <= JOB_STORAGE &&
+                          alignof(Callable) <= alignof(std::max_align_t),
+                      "job captures too large, capture by reference");
+        uint32_t index = AllocateJob();
+        Job& job = jobs[index];
+        new (job.storage) Callable(std::forward<Fn>(fn));
+        job.invoke = [](void* callable) { (*static_cast<Callable*>(callable))(); };
+        job.destroy = [](void* callable) { static_cast<Callable*>(callable)->~Callable(); };
+        job.unmetDependencies.store(1, std::memory_order_relaxed);
+        return {index, job.generation.load(std::memory_order_relaxed)};
+    }
+    void Depend(JobHandle job, JobHandle on);
+    void Release(JobHandle job);
+
+   public:
+    // workerCount 0 picks one worker per logical core, minus the calling thread
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // runs fn() on some thread once every dependency is done
+    template <typename Fn>
+    JobHandle Schedule(Fn&& fn, std::initializer_list<JobHandle> dependencies = {})
+    {
+        JobHandle job = Create(std::forward<Fn>(fn));
+        for (JobHandle dependency : dependencies)
+            Depend(job, dependency);
+        Release(job);
+        return job;
+    }
+
+    // Calls fn(begin, end) over [0, count) split into ranges of at least grain items;
+    // the returned handle is done when all of them are. fn is copied into every range
+    // job, and each index is visited exactly once, so a body that only writes its own
+    // indices gives the same result as a serial loop. A count that fits in one range
+    // runs right here after the dependencies.
+    template <typename Fn>
+    JobHandle ParallelFor(uint32_t count, uint32_t grain, const Fn& fn,
+                          std::initializer_list<JobHandle> dependencies = {})
+    {
+        // cap the range count well below the pool, a held join must not starve it
+        grain = std::max({grain, 1u, (count + MAX_JOBS / 4 - 1) / (MAX_JOBS / 4)});
+        if (count <= grain)
+        {
+            for (JobHandle dependency : dependencies)
+                Wait(dependency);
+            fn(0u, count);
+            return {};
+        }
+
+        JobHandle join = Create([] {});
+        for (uint32_t begin = 0; begin < count; begin += grain)
+        {
+            uint32_t end = std::min(begin + grain, count);
+            JobHandle range = Create([fn, begin, end] { fn(begin, end); });
+            for (JobHandle dependency : dependencies)
+                Depend(range, dependency);
+            Depend(join, range);
+            Release(range);
+        }
+        Release(join);
+        return join;
+    }
+
+    bool IsDone(JobHandle job) const
+    {
+        return job.generation == 0 ||
+               jobs[job.index].generation.load(std::memory_order_acquire) != job.generation;
+    }
+    // runs other jobs until job is done
+    void Wait(JobHandle job);
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+};
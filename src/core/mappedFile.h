@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only file mapped copy-on-write: pages come straight from the page cache and
+// are only copied if the program writes to them, nothing is written back to disk.
+class MappedFile
+{
+    uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+   public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+};
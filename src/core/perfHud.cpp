@@ -0,0 +1,74 @@
+#include "perfHud.h"
+
+#include <SDL3/SDL_stdinc.h>
+
+#include <algorithm>
+#include <cmath>
+
+void PerfHud::RecordFrame(uint64_t frameNs, uint64_t allocations)
+{
+    frameMs[next] = frameNs / 1e6f;
+    next = (next + 1) % HISTORY;
+    count = std::min(count + 1, HISTORY);
+    frameAllocations = allocations;
+}
+
+void PerfHud::Draw(SDL_Renderer* renderer, const LevelStats& stats, float x, float y,
+                   float budgetMs, const char* pacing)
+{
+    if (count == 0)
+        return;
+
+    // oldest sample first, the graph scrolls left
+    const int first = (next - count + HISTORY) % HISTORY;
+    float minMs = frameMs[first];
+    float sumMs = 0.0f;
+    const float graphTop = y + 4 * LINE_HEIGHT + 4.0f;
+    const float scale = GRAPH_HEIGHT / (2.0f * budgetMs);
+    for (int i = 0; i < count; i++)
+    {
+        float ms = frameMs[(first + i) % HISTORY];
+        minMs = std::min(minMs, ms);
+        sumMs += ms;
+        sorted[i] = ms;
+        graph[i] = {x + 2.0f + i, graphTop + GRAPH_HEIGHT - std::min(ms * scale, GRAPH_HEIGHT)};
+    }
+    // jitter as the standard deviation of the window
+    const float avgMs = sumMs / count;
+    float squaredMs = 0.0f;
+    for (int i = 0; i < count; i++)
+        squaredMs += (sorted[i] - avgMs) * (sorted[i] - avgMs);
+    const float jitterMs = std::sqrt(squaredMs / count);
+    const int p99 = (count * 99 + 99) / 100 - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + p99, sorted.begin() + count);
+    const float lastMs = frameMs[(next - 1 + HISTORY) % HISTORY];
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_FRect panel = {x, y, PANEL_WIDTH, PANEL_HEIGHT};
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_SetRenderDrawColor(renderer, 200, 200, 60, 255);
+    float budgetY = graphTop + GRAPH_HEIGHT - budgetMs * scale;
+    SDL_RenderLine(renderer, x + 2.0f, budgetY, x + 2.0f + HISTORY, budgetY);
+    SDL_SetRenderDrawColor(renderer, 80, 220, 120, 255);
+    if (count > 1)
+        SDL_RenderLines(renderer, graph.data(), count);
+
+    char line[96];
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_snprintf(line, sizeof(line), "frame %6.2f ms  min %6.2f  avg %6.2f  p99 %6.2f", lastMs,
+                 minMs, avgMs, sorted[p99]);
+    SDL_RenderDebugText(renderer, x + 2.0f, y + 2.0f, line);
+    SDL_snprintf(line, sizeof(line), "update %.3f  coll %.3f  ground %.3f  render %.3f ms",
+                 stats.updateNs / 1e6, stats.collisionNs / 1e6, stats.groundNs / 1e6,
+                 stats.renderNs / 1e6);
+    SDL_RenderDebugText(renderer, x + 2.0f, y + 2.0f + LINE_HEIGHT, line);
+    SDL_snprintf(line, sizeof(line), "entities %u  bullets %u  draws %u  allocs %u",
+                 stats.entityCount, stats.bulletCount, stats.drawCalls,
+                 static_cast<unsigned>(frameAllocations));
+    SDL_RenderDebugText(renderer, x + 2.0f, y + 2.0f + 2 * LINE_HEIGHT, line);
+    SDL_snprintf(line, sizeof(line), "pacing %s  jitter %.3f ms", pacing, jitterMs);
+    SDL_RenderDebugText(renderer, x + 2.0f, y + 2.0f + 3 * LINE_HEIGHT, line);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <array>
+#include <cstdint>
+
+#include "game/Level.h"
+
+// F3 performance overlay: a rolling frame-time graph, min/avg/p99 and jitter over the
+// same window, the last tick's phase split, the per-frame counters and the pacing mode.
+// Samples live in fixed arrays and the text goes through SDL_snprintf into stack buffers,
+// so drawing it allocates nothing and the allocation counter it shows stays honest.
+class PerfHud
+{
+   public:
+    // frames kept, one pixel of graph each
+    static constexpr int HISTORY = 240;
+    static constexpr float GRAPH_HEIGHT = 48.0f;
+    static constexpr float LINE_HEIGHT = 10.0f;
+    static constexpr float PANEL_WIDTH = 420.0f;
+    static constexpr float PANEL_HEIGHT = 4 * LINE_HEIGHT + GRAPH_HEIGHT + 8.0f;
+
+   private:
+    std::array<float, HISTORY> frameMs{};
+    // copy of the window that nth_element may reorder for the percentile
+    std::array<float, HISTORY> sorted{};
+    std::array<SDL_FPoint, HISTORY> graph{};
+    int next = 0;
+    int count = 0;
+    uint64_t frameAllocations = 0;
+
+   public:
+    // frameNs is the duration of the frame that just ended, allocations the heap
+    // allocations made during it
+    void RecordFrame(uint64_t frameNs, uint64_t allocations);
+    // panel with its top-left corner at (x, y); budgetMs is drawn as a reference line
+    // at half the graph height, pacing names the frame pacing mode
+    void Draw(SDL_Renderer* renderer, const LevelStats& stats, float x, float y, float budgetMs,
+              const char* pacing);
+};
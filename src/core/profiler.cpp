@@ -0,0 +1,117 @@
+#include "profiler.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+struct ZoneEvent
+{
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+// one per thread that ever named itself or recorded a zone, never freed before exit so
+// the trace still has the zones of threads that are gone
+struct ThreadBuffer
+{
+    uint32_t id = 0;
+    const char* name = nullptr;
+    std::unique_ptr<ZoneEvent[]> events;
+    // zones recorded so far, the newest RING_CAPACITY of them are in events
+    std::atomic<uint64_t> written{0};
+};
+
+std::atomic<bool> recording{false};
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer& GetLocalBuffer()
+{
+    if (!localBuffer)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        localBuffer = buffers.back().get();
+        localBuffer->id = static_cast<uint32_t>(buffers.size());
+    }
+    return *localBuffer;
+}
+}  // namespace
+
+void Profiler::Start() { recording.store(true, std::memory_order_relaxed); }
+
+bool Profiler::IsRecording() { return recording.load(std::memory_order_relaxed); }
+
+void Profiler::SetThreadName(const char* name) { GetLocalBuffer().name = name; }
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs)
+{
+    ThreadBuffer& buffer = GetLocalBuffer();
+    if (!buffer.events)
+        buffer.events = std::make_unique<ZoneEvent[]>(RING_CAPACITY);
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % RING_CAPACITY] = {name, startNs, endNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::WriteTrace(const std::string& path)
+{
+    recording.store(false, std::memory_order_relaxed);
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        SDL_Log("Cannot write trace %s", path.c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    uint64_t zoneCount = 0;
+    bool first = true;
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers)
+    {
+        if (buffer->name)
+        {
+            std::fprintf(file,
+                         "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                         "\"args\":{\"name\":\"%s\"}}",
+                         first ? "" : ",", buffer->id, buffer->name);
+            first = false;
+        }
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+        for (uint64_t i = begin; i < written; i++)
+        {
+            // trace timestamps are microseconds, the fraction keeps nanosecond precision
+            const ZoneEvent& event = buffer->events[i % RING_CAPACITY];
+            std::fprintf(file,
+                         "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                         "\"ts\":%" PRIu64 ".%03u,\"dur\":%" PRIu64 ".%03u}",
+                         first ? "" : ",", event.name, buffer->id, event.startNs / 1000,
+                         static_cast<unsigned>(event.startNs % 1000),
+                         (event.endNs - event.startNs) / 1000,
+                         static_cast<unsigned>((event.endNs - event.startNs) % 1000));
+            first = false;
+        }
+        zoneCount += written - begin;
+    }
+    std::fputs("\n]}\n", file);
+
+    bool success = std::fclose(file) == 0;
+    if (success)
+        SDL_Log("Wrote %" PRIu64 " zones to %s", zoneCount, path.c_str());
+    else
+        SDL_Log("Cannot write trace %s", path.c_str());
+    return success;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <SDL3/SDL_timer.h>
+
+#include <cstdint>
+#include <string>
+
+// Scoped-zone profiler. PROFILE_ZONE("name") times the rest of the enclosing scope and
+// stores it in a ring buffer owned by the calling thread, so recording takes no lock
+// and never allocates after the thread's first zone. Zones are only recorded between
+// Profiler::Start() and WriteTrace(); builds without GALAXY_PROFILE compile them out.
+// Names must be string literals, they are stored as pointers and written unescaped.
+
+namespace Profiler
+{
+// events kept per thread, older ones are overwritten
+inline constexpr uint32_t RING_CAPACITY = 1 << 16;
+
+#ifdef GALAXY_PROFILE
+inline constexpr bool CompiledIn = true;
+#else
+inline constexpr bool CompiledIn = false;
+#endif
+
+void Start();
+bool IsRecording();
+// label for the calling thread in the trace, call before its first zone
+void SetThreadName(const char* name);
+void Record(const char* name, uint64_t startNs, uint64_t endNs);
+// stops recording and writes every buffered zone as Chrome trace-event JSON, which
+// chrome://tracing and ui.perfetto.dev open. Call once the worker threads are idle.
+bool WriteTrace(const std::string& path);
+}  // namespace Profiler
+
+class ProfileZone
+{
+    const char* name;
+    uint64_t start = 0;
+    bool active;
+
+   public:
+    explicit ProfileZone(const char* zoneName) : name(zoneName), active(Profiler::IsRecording())
+    {
+        if (active)
+            start = SDL_GetTicksNS();
+    }
+    ~ProfileZone()
+    {
+        if (active)
+            Profiler::Record(name, start, SDL_GetTicksNS());
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#ifdef GALAXY_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
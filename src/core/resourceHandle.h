@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+using NameHash = uint32_t;
+
+// 32-bit FNV-1a. constexpr so built-in asset names hash at compile time
+constexpr NameHash HashName(std::string_view name)
+{
+    NameHash hash = 2166136261u;
+    for (char c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Index into one of the ResourceManager tables plus the generation of the slot it
+// was issued for. A handle outlived by an unload fails the generation check instead
+// of reading whatever took the slot. Tag keeps handles of different tables apart.
+template <typename Tag>
+struct Handle
+{
+    uint32_t index = 0;
+    uint32_t generation = 0;  // live slots start at 1, so a default handle never matches
+
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const Handle&) const = default;
+};
+
+struct SpriteTag;
+using SpriteHandle = Handle<SpriteTag>;
@@ -2,8 +2,11 @@
 
 #include <SDL3/SDL_filesystem.h>
 
+#include <algorithm>
 #include <string>
 
+#include "profiler.h"
+
 ResourceManager::ResourceManager(SDL_Renderer* renderer, const char* basePath)
     : renderer(renderer), basePath(basePath)
 {
@@ -11,16 +14,80 @@ ResourceManager::ResourceManager(SDL_Renderer* renderer, const char* basePath)
 
 ResourceManager::~ResourceManager() { UnloadAll(); }
 
+bool ResourceManager::IsKnownFile(const std::string& filepath) const
+{
+    if (regions.count(filepath))
+        return true;
+    for (const PendingImage& image : pending)
+    {
+        if (image.filepath == filepath)
+            return true;
+    }
+    return false;
+}
+
+bool ResourceManager::RegisterName(const std::string& name, const std::string& filepath)
+{
+    NameHash hash = HashName(name);
+    auto found = spriteByName.find(hash);
+    if (found == spriteByName.end())
+    {
+        spriteByName[hash] = static_cast<uint32_t>(sprites.size());
+        sprites.push_back({name, filepath, {}, 1});
+        return true;
+    }
+
+    SpriteSlot& slot = sprites[found->second];
+    if (slot.name != name)
+    {
+        SDL_Log("Resource name hash collision: %s and %s", slot.name.c_str(), name.c_str());
+        return false;
+    }
+    if (slot.filepath != filepath)
+    {
+        // repointing a name invalidates the handles issued for the old image
+        slot.filepath = filepath;
+        slot.region = {};
+        slot.generation++;
+    }
+    return true;
+}
+
+void ResourceManager::RefreshSprites()
+{
+    for (SpriteSlot& slot : sprites)
+    {
+        auto region = regions.find(slot.filepath);
+        if (region != regions.end())
+            slot.region = region->second;
+    }
+}
+
+SpriteHandle ResourceManager::Find(NameHash name) const
+{
+    auto found = spriteByName.find(name);
+    if (found == spriteByName.end())
+        return {};
+    return {found->second, sprites[found->second].generation};
+}
+
 void ResourceManager::LoadTexture(const std::string& name, const std::string& filepath)
 {
+    if (!RegisterName(name, filepath))
+        return;
+    if (IsKnownFile(filepath))
+    {
+        RefreshSprites();
+        return;
+    }
+
     // Build full path
     std::string fullPath = std::string(basePath) + filepath;
 
-    SDL_Texture* tex = IMG_LoadTexture(renderer, fullPath.c_str());
-    if (tex)
+    SDL_Surface* surface = IMG_Load(fullPath.c_str());
+    if (surface)
     {
-        SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
-        textures[name] = tex;
+        pending.push_back({filepath, surface});
     }
     else
     {
@@ -28,20 +95,186 @@ void ResourceManager::LoadTexture(const std::string& name, const std::string& fi
     }
 }
 
-SDL_Texture* ResourceManager::GetTexture(const std::string& name) const
+ResourceManager::LoadHandle ResourceManager::LoadTextureAsync(const std::string& name,
+                                                              const std::string& filepath)
+{
+    if (!RegisterName(name, filepath))
+        return InvalidLoad;
+    // a file already in flight under another name shares that load
+    for (size_t i = 0; i < loads.size(); i++)
+    {
+        if (loads[i].filepath == filepath)
+            return static_cast<LoadHandle>(i);
+    }
+
+    if (!decodePool)
+        decodePool = std::make_unique<ThreadPool>();
+
+    std::string fullPath = std::string(basePath) + filepath;
+    std::future<SDL_Surface*> surface = decodePool->Submit(
+        [fullPath]() -> SDL_Surface*
+        {
+            PROFILE_ZONE("DecodeImage");
+            SDL_Surface* decoded = IMG_Load(fullPath.c_str());
+            if (!decoded || decoded->format == SDL_PIXELFORMAT_RGBA32)
+                return decoded;
+            // convert here too, so the atlas blit on the main thread is a plain copy
+            SDL_Surface* converted = SDL_ConvertSurface(decoded, SDL_PIXELFORMAT_RGBA32);
+            SDL_DestroySurface(decoded);
+            return converted;
+        });
+    loads.push_back({filepath, std::move(surface), LoadState::Pending});
+    return static_cast<LoadHandle>(loads.size() - 1);
+}
+
+bool ResourceManager::PumpLoads()
+{
+    for (AsyncLoad& load : loads)
+    {
+        if (load.state != LoadState::Pending ||
+            load.surface.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            continue;
+
+        SDL_Surface* surface = load.surface.get();
+        if (!surface)
+        {
+            SDL_Log("Failed to load texture: %s%s", basePath, load.filepath.c_str());
+            load.state = LoadState::Failed;
+        }
+        else
+        {
+            if (IsKnownFile(load.filepath))
+                SDL_DestroySurface(surface);
+            else
+                pending.push_back({load.filepath, surface});
+            load.state = LoadState::Ready;
+        }
+
+        loadsFinished++;
+        if (onProgress)
+            onProgress(loadsFinished, loads.size());
+    }
+    return loadsFinished == loads.size();
+}
+
+void ResourceManager::WaitForLoads()
+{
+    PROFILE_ZONE("WaitForLoads");
+    while (!PumpLoads())
+    {
+        // sleep on the oldest unfinished decode, then sweep up everything that is done
+        for (AsyncLoad& load : loads)
+        {
+            if (load.state == LoadState::Pending)
+            {
+                load.surface.wait();
+                break;
+            }
+        }
+    }
+}
+
+bool ResourceManager::BuildAtlas()
 {
-    if (textures.find(name) != textures.end())
+    PROFILE_ZONE("BuildAtlas");
+    // tallest first keeps the skyline flat
+    std::sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b)
+              { return a.surface->h > b.surface->h; });
+
+    struct Page
     {
-        return textures.at(name);
+        SkylinePacker packer;
+        SDL_Surface* surface;
+        std::vector<std::pair<std::string, SDL_FRect>> placed;
+    };
+    std::vector<Page> built;
+    bool success = true;
+
+    for (const PendingImage& image : pending)
+    {
+        int w = image.surface->w + PADDING * 2;
+        int h = image.surface->h + PADDING * 2;
+        SDL_Point position;
+        Page* page = nullptr;
+        for (Page& candidate : built)
+        {
+            if (candidate.packer.Insert(w, h, position))
+            {
+                page = &candidate;
+                break;
+            }
+        }
+        if (!page)
+        {
+            int pageW = std::max(PAGE_SIZE, w);
+            int pageH = std::max(PAGE_SIZE, h);
+            SDL_Surface* surface = SDL_CreateSurface(pageW, pageH, SDL_PIXELFORMAT_RGBA32);
+            if (!surface)
+            {
+                SDL_Log("Atlas page creation failed: %s", SDL_GetError());
+                success = false;
+                break;
+            }
+            SDL_ClearSurface(surface, 0.0f, 0.0f, 0.0f, 0.0f);
+            built.push_back({SkylinePacker(pageW, pageH), surface, {}});
+            page = &built.back();
+            page->packer.Insert(w, h, position);
+        }
+
+        SDL_Rect dst = {position.x + PADDING, position.y + PADDING, image.surface->w,
+                        image.surface->h};
+        // copy the pixels as they are, alpha included
+        SDL_SetSurfaceBlendMode(image.surface, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(image.surface, nullptr, page->surface, &dst);
+        page->placed.push_back({image.filepath, {static_cast<float>(dst.x),
+                                                 static_cast<float>(dst.y),
+                                                 static_cast<float>(dst.w),
+                                                 static_cast<float>(dst.h)}});
     }
-    return nullptr;
+
+    for (Page& page : built)
+    {
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, page.surface);
+        SDL_DestroySurface(page.surface);
+        if (!tex)
+        {
+            SDL_Log("Atlas page upload failed: %s", SDL_GetError());
+            success = false;
+            continue;
+        }
+        SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
+        pages.push_back(tex);
+        for (const auto& [filepath, rect] : page.placed)
+            regions[filepath] = {tex, rect};
+    }
+    RefreshSprites();
+
+    for (PendingImage& image : pending)
+        SDL_DestroySurface(image.surface);
+    pending.clear();
+    return success;
 }
 
 void ResourceManager::UnloadAll()
 {
-    for (auto& pair : textures)
+    // in-flight decodes still own their surfaces
+    WaitForLoads();
+    loads.clear();
+    loadsFinished = 0;
+
+    for (SDL_Texture* page : pages)
+    {
+        SDL_DestroyTexture(page);
+    }
+    pages.clear();
+    regions.clear();
+    // names stay resolvable, but every handle issued so far goes stale
+    for (SpriteSlot& slot : sprites)
     {
-        SDL_DestroyTexture(pair.second);
+        slot.region = {};
+        slot.generation++;
     }
-    textures.clear();
+    for (PendingImage& image : pending)
+        SDL_DestroySurface(image.surface);
+    pending.clear();
 }
@@ -2,22 +2,115 @@
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "atlasPacker.h"
+#include "resourceHandle.h"
+#include "threadPool.h"
+
+enum class LoadState
+{
+    Pending,
+    Ready,
+    Failed,
+};
+
+// Loads images and packs them into shared atlas pages, so sprites of different
+// sheets can go out in the same batch. LoadTexture only decodes; BuildAtlas packs
+// everything loaded since the previous call into new pages and uploads them.
+// LoadTextureAsync moves the decode onto a worker pool; only the main thread
+// touches the renderer, in PumpLoads and BuildAtlas.
+// Names are resolved to a SpriteHandle once (Find), after that Get is a checked
+// array index with no string work.
 class ResourceManager
 {
+    struct PendingImage
+    {
+        std::string filepath;
+        SDL_Surface* surface;
+    };
+    struct SpriteSlot
+    {
+        std::string name;
+        std::string filepath;
+        AtlasRegion region;
+        uint32_t generation = 1;
+    };
+    struct AsyncLoad
+    {
+        std::string filepath;
+        std::future<SDL_Surface*> surface;
+        LoadState state;
+    };
+
     SDL_Renderer* renderer;
-    std::unordered_map<std::string, SDL_Texture*> textures;
+    // every page texture, owned here
+    std::vector<SDL_Texture*> pages;
+    // packed files, a file loaded under several names is packed once
+    std::unordered_map<std::string, AtlasRegion> regions;
+    // dense sprite table indexed by SpriteHandle, one slot per name
+    std::vector<SpriteSlot> sprites;
+    std::unordered_map<NameHash, uint32_t> spriteByName;
+    std::vector<PendingImage> pending;
     const char* basePath;
+    // created on the first async load, handles index loads
+    std::unique_ptr<ThreadPool> decodePool;
+    std::vector<AsyncLoad> loads;
+    size_t loadsFinished = 0;
+    std::function<void(size_t, size_t)> onProgress;
+
+    bool IsKnownFile(const std::string& filepath) const;
+    // adds or repoints the slot for name, false on a hash collision with another name
+    bool RegisterName(const std::string& name, const std::string& filepath);
+    // copies packed regions into the slots that reference them
+    void RefreshSprites();
 
    public:
+    // pages are square, images larger than this get a page of their own
+    static const int PAGE_SIZE = 1024;
+    // transparent gap around each image so filtering never samples a neighbour
+    static const int PADDING = 1;
+
     ResourceManager(SDL_Renderer* renderer, const char* basePath);
     ~ResourceManager();
 
+    using LoadHandle = uint32_t;
+    static const LoadHandle InvalidLoad = 0xFFFFFFFFu;
+
     void LoadTexture(const std::string& name, const std::string& filepath);
+    // decodes on the worker pool, the image joins the next BuildAtlas once pumped
+    LoadHandle LoadTextureAsync(const std::string& name, const std::string& filepath);
+    LoadState GetLoadState(LoadHandle handle) const
+    {
+        return handle < loads.size() ? loads[handle].state : LoadState::Failed;
+    }
+    // called on the main thread as fn(finished, total) each time an async load completes
+    void SetProgressCallback(std::function<void(size_t, size_t)> fn) { onProgress = fn; }
+    // collects finished decodes without blocking, true once every async load is done
+    bool PumpLoads();
+    // blocks until every async load is done
+    void WaitForLoads();
+    bool BuildAtlas();
 
-    SDL_Texture* GetTexture(const std::string& name) const;
+    // invalid handle when the name was never loaded
+    SpriteHandle Find(NameHash name) const;
+    SpriteHandle Find(std::string_view name) const { return Find(HashName(name)); }
+    // region behind a handle, empty (null texture) when stale or not packed yet
+    const AtlasRegion& Get(SpriteHandle handle) const
+    {
+        static const AtlasRegion empty;
+        if (handle.index >= sprites.size() || sprites[handle.index].generation != handle.generation)
+            return empty;
+        return sprites[handle.index].region;
+    }
+    size_t GetPageCount() const { return pages.size(); }
 
     void UnloadAll();
 };
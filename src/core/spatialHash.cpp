@@ -0,0 +1,70 @@
+#include "spatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize, uint32_t bucketCount) : cellSize(cellSize)
+{
+    uint32_t buckets = 1;
+    while (buckets < bucketCount)
+        buckets <<= 1;
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+}
+
+int SpatialHash::CellCoord(float v) const { return static_cast<int>(std::floor(v / cellSize)); }
+
+uint32_t SpatialHash::Hash(int cx, int cy) const
+{
+    return ((static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u)) &
+           bucketMask;
+}
+
+void SpatialHash::Reserve(uint32_t bodyCount, uint32_t cellsPerBody)
+{
+    bodies.reserve(bodyCount);
+    entries.reserve(size_t(bodyCount) * cellsPerBody);
+    items.reserve(size_t(bodyCount) * cellsPerBody);
+}
+
+void SpatialHash::Clear()
+{
+    bodies.clear();
+    entries.clear();
+    pairsTested = 0;
+}
+
+void SpatialHash::Insert(uint32_t id, const SDL_FRect& rect)
+{
+    uint32_t body = static_cast<uint32_t>(bodies.size());
+    bodies.push_back({rect, id, queryStamp});
+
+    int cx0 = CellCoord(rect.x), cx1 = CellCoord(rect.x + rect.w);
+    int cy0 = CellCoord(rect.y), cy1 = CellCoord(rect.y + rect.h);
+    for (int cy = cy0; cy <= cy1; cy++)
+    {
+        for (int cx = cx0; cx <= cx1; cx++)
+        {
+            entries.push_back({Hash(cx, cy), body});
+        }
+    }
+}
+
+void SpatialHash::Build()
+{
+    // counting sort of the entries by bucket into one flat items array
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+    for (const Entry& e : entries)
+        bucketStart[e.bucket + 1]++;
+    for (size_t b = 1; b < bucketStart.size(); b++)
+        bucketStart[b] += bucketStart[b - 1];
+
+    items.resize(entries.size());
+    for (const Entry& e : entries)
+        items[bucketStart[e.bucket]++] = e.body;
+
+    // the fill pass advanced every start to the next bucket, shift them back
+    for (size_t b = bucketStart.size() - 1; b > 0; b--)
+        bucketStart[b] = bucketStart[b - 1];
+    bucketStart[0] = 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+
+#include <cstdint>
+#include <vector>
+
+// Uniform-grid spatial hash for dynamic bodies. Rebuilt every tick:
+// Clear(), Insert() each body, Build(), then Query() as often as needed.
+// Storage is reused between ticks so a steady scene does not allocate.
+class SpatialHash
+{
+    struct Body
+    {
+        SDL_FRect rect;
+        uint32_t id;
+        uint32_t stamp;
+    };
+    struct Entry
+    {
+        uint32_t bucket;
+        uint32_t body;
+    };
+
+    float cellSize;
+    uint32_t bucketMask;
+    std::vector<Body> bodies;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> bucketStart;
+    std::vector<uint32_t> items;
+    uint32_t queryStamp = 0;
+    uint64_t pairsTested = 0;
+
+    int CellCoord(float v) const;
+    uint32_t Hash(int cx, int cy) const;
+
+   public:
+    // bucketCount is rounded up to a power of two
+    explicit SpatialHash(float cellSize = 64.0f, uint32_t bucketCount = 4096);
+
+    // room for bodyCount bodies covering up to cellsPerBody cells each, so a scene that
+    // grows to that many does not reallocate mid-run
+    void Reserve(uint32_t bodyCount, uint32_t cellsPerBody = 4);
+    void Clear();
+    void Insert(uint32_t id, const SDL_FRect& rect);
+    void Build();
+
+    // Calls fn(id, bodyRect) once for every body whose cells the rect touches.
+    // Candidates still need a narrowphase test; each one counts as a tested pair.
+    template <typename Fn>
+    void Query(const SDL_FRect& rect, Fn&& fn)
+    {
+        if (bodies.empty())
+            return;
+
+        queryStamp++;
+        int cx0 = CellCoord(rect.x), cx1 = CellCoord(rect.x + rect.w);
+        int cy0 = CellCoord(rect.y), cy1 = CellCoord(rect.y + rect.h);
+        for (int cy = cy0; cy <= cy1; cy++)
+        {
+            for (int cx = cx0; cx <= cx1; cx++)
+            {
+                uint32_t bucket = Hash(cx, cy);
+                for (uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++)
+                {
+                    Body& body = bodies[items[i]];
+                    if (body.stamp == queryStamp)
+                        continue;
+                    body.stamp = queryStamp;
+                    pairsTested++;
+                    fn(body.id, body.rect);
+                }
+            }
+        }
+    }
+
+    size_t GetBodyCount() const { return bodies.size(); }
+    uint64_t GetPairsTested() const { return pairsTested; }
+};
@@ -0,0 +1,119 @@
+#include "spriteBatch.h"
+
+#include <utility>
+
+#include "profiler.h"
+
+uint32_t SpriteBatch::FindBucket(SDL_Texture* texture)
+{
+    // runs of sprites nearly always share a texture
+    if (lastBucket < buckets.size() && buckets[lastBucket].texture == texture)
+        return lastBucket;
+
+    uint32_t freeBucket = static_cast<uint32_t>(buckets.size());
+    for (uint32_t b = 0; b < buckets.size(); b++)
+    {
+        if (buckets[b].texture == texture)
+            return lastBucket = b;
+        if (!buckets[b].texture && freeBucket == buckets.size())
+            freeBucket = b;
+    }
+
+    float w = 1.0f, h = 1.0f;
+    SDL_GetTextureSize(texture, &w, &h);
+    if (freeBucket == buckets.size())
+        buckets.push_back({});
+    Bucket& bucket = buckets[freeBucket];
+    bucket.texture = texture;
+    bucket.invWidth = 1.0f / w;
+    bucket.invHeight = 1.0f / h;
+    return lastBucket = freeBucket;
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst,
+                       SDL_FlipMode flip)
+{
+    // missing assets draw nothing, like SDL_RenderTexture with a null texture
+    if (!texture)
+        return;
+
+    uint32_t b = FindBucket(texture);
+    Bucket& bucket = buckets[b];
+    if (bucket.vertices.empty())
+        pending.push_back(b);
+
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src)
+    {
+        u0 = src->x * bucket.invWidth;
+        v0 = src->y * bucket.invHeight;
+        u1 = (src->x + src->w) * bucket.invWidth;
+        v1 = (src->y + src->h) * bucket.invHeight;
+    }
+    if (flip & SDL_FLIP_HORIZONTAL)
+        std::swap(u0, u1);
+    if (flip & SDL_FLIP_VERTICAL)
+        std::swap(v0, v1);
+
+    const SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+    float x0 = dst.x, y0 = dst.y;
+    float x1 = dst.x + dst.w, y1 = dst.y + dst.h;
+    bucket.vertices.push_back({{x0, y0}, white, {u0, v0}});
+    bucket.vertices.push_back({{x1, y0}, white, {u1, v0}});
+    bucket.vertices.push_back({{x0, y1}, white, {u0, v1}});
+    bucket.vertices.push_back({{x1, y1}, white, {u1, v1}});
+    stats.quads++;
+}
+
+void SpriteBatch::Reserve(SDL_Texture* texture, uint32_t quads)
+{
+    if (!texture)
+        return;
+    buckets[FindBucket(texture)].vertices.reserve(size_t(quads) * 4);
+    indices.reserve(size_t(quads) * 6);
+    // a bucket is pending at most once per flush
+    pending.reserve(buckets.size());
+}
+
+void SpriteBatch::ReserveTextures(uint32_t count)
+{
+    // free buckets, FindBucket hands them to the next new textures
+    for (uint32_t i = 0; i < count; i++)
+    {
+        buckets.push_back({});
+        buckets.back().vertices.reserve(4);
+    }
+    pending.reserve(buckets.size());
+}
+
+void SpriteBatch::Forget(SDL_Texture* texture)
+{
+    for (Bucket& bucket : buckets)
+    {
+        if (bucket.texture == texture)
+            bucket.texture = nullptr;
+    }
+}
+
+void SpriteBatch::Flush(SDL_Renderer* renderer)
+{
+    PROFILE_ZONE("SpriteBatch::Flush");
+    for (uint32_t b : pending)
+    {
+        Bucket& bucket = buckets[b];
+        size_t vertexCount = bucket.vertices.size();
+        size_t indexCount = vertexCount / 4 * 6;
+        while (indices.size() < indexCount)
+        {
+            int base = static_cast<int>(indices.size() / 6 * 4);
+            indices.insert(indices.end(), {base, base + 1, base + 2, base + 2, base + 1, base + 3});
+        }
+
+        SDL_RenderGeometry(renderer, bucket.texture, bucket.vertices.data(),
+                           static_cast<int>(vertexCount), indices.data(),
+                           static_cast<int>(indexCount));
+        stats.drawCalls++;
+        bucket.vertices.clear();
+    }
+    pending.clear();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <cstdint>
+#include <vector>
+
+struct SpriteBatchStats
+{
+    uint32_t drawCalls = 0;  // SDL_RenderGeometry submissions
+    uint32_t quads = 0;      // sprites queued through Draw
+};
+
+// Collects textured quads per texture and submits each texture with one
+// SDL_RenderGeometry call on Flush(). Sprites keep their order within a texture but
+// not across textures, so flush at every layer boundary that has to stay on top.
+// Vertex storage is reused between frames; textures must outlive the batch or be
+// forgotten before they are destroyed.
+class SpriteBatch
+{
+    struct Bucket
+    {
+        SDL_Texture* texture;
+        float invWidth, invHeight;  // turn pixel src rects into uvs
+        std::vector<SDL_Vertex> vertices;
+    };
+
+    std::vector<Bucket> buckets;
+    // buckets holding quads, in the order of their first Draw since the last Flush
+    std::vector<uint32_t> pending;
+    // two triangles per quad, shared by every bucket and grown on demand
+    std::vector<int> indices;
+    uint32_t lastBucket = 0;
+    SpriteBatchStats stats;
+
+    uint32_t FindBucket(SDL_Texture* texture);
+
+   public:
+    // src == nullptr draws the whole texture
+    void Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst,
+              SDL_FlipMode flip = SDL_FLIP_NONE);
+    void Flush(SDL_Renderer* renderer);
+    // room for quads sprites of texture between two flushes, so a busy frame after
+    // startup does not have to grow the buffers
+    void Reserve(SDL_Texture* texture, uint32_t quads);
+    // room for count more textures of one quad each, for textures made while running
+    void ReserveTextures(uint32_t count);
+    // call before destroying a texture that was drawn, its bucket and vertex storage
+    // are then reused by the next new texture; nothing of it may be pending
+    void Forget(SDL_Texture* texture);
+
+    // stats add up over every Flush until the next reset, reset once per frame
+    void ResetStats() { stats = {}; }
+    const SpriteBatchStats& GetStats() const { return stats; }
+};
@@ -0,0 +1,53 @@
+#include "sweep.h"
+
+#include <limits>
+
+namespace
+{
+// Entry and exit time of the span [a0, a1] moving by d across [b0, b1]. False when
+// they can not meet on this axis during the move.
+bool SweepAxis(float a0, float a1, float d, float b0, float b1, float& entry, float& exit)
+{
+    if (d == 0.0f)
+    {
+        // standing still on this axis, the spans have to overlap the whole time
+        entry = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+        return a0 < b1 - SWEEP_SKIN && b0 < a1 - SWEEP_SKIN;
+    }
+
+    const float speed = d > 0.0f ? d : -d;
+    // distance to the first touch (negative when already inside) and to separation
+    float toEntry = d > 0.0f ? b0 - a1 : a0 - b1;
+    float toExit = d > 0.0f ? b1 - a0 : a1 - b0;
+    // out of reach or already parting, most tiles near a mover stop here
+    if (toEntry > speed || toExit <= SWEEP_SKIN)
+        return false;
+    if (toEntry < 0.0f && toEntry >= -SWEEP_SKIN)
+        toEntry = 0.0f;
+    entry = toEntry / speed;
+    exit = toExit / speed;
+    return true;
+}
+}  // namespace
+
+bool SweepBox(const SDL_FRect& box, glm::vec2 delta, const SDL_FRect& target, SweepHit& hit)
+{
+    float entryX, exitX, entryY, exitY;
+    if (!SweepAxis(box.x, box.x + box.w, delta.x, target.x, target.x + target.w, entryX, exitX) ||
+        !SweepAxis(box.y, box.y + box.h, delta.y, target.y, target.y + target.h, entryY, exitY))
+        return false;
+
+    // they touch once both axes overlap and part as soon as either stops
+    float entry = entryX > entryY ? entryX : entryY;
+    float exit = exitX < exitY ? exitX : exitY;
+    if (entry < 0.0f || entry > 1.0f || entry > exit)
+        return false;
+
+    hit.time = entry;
+    if (entryX > entryY)
+        hit.normal = {delta.x > 0.0f ? -1.0f : 1.0f, 0.0f};
+    else
+        hit.normal = {0.0f, delta.y > 0.0f ? -1.0f : 1.0f};
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+
+#include <glm/glm.hpp>
+
+// Overlaps up to this deep (pixels) count as touching. A body resting on a surface is
+// off by float rounding either way, this keeps it from reading as stuck inside.
+inline constexpr float SWEEP_SKIN = 0.01f;
+
+// first contact of a moving box
+struct SweepHit
+{
+    // fraction of the move done when the boxes meet, 1 when they never do
+    float time = 1.0f;
+    // axis normal of the surface that was hit, pointing against the motion, zero
+    // when nothing was hit
+    glm::vec2 normal{0.0f};
+
+    bool IsHit() const { return normal.x != 0.0f || normal.y != 0.0f; }
+};
+
+// Moves box by delta against a box standing still, for two moving boxes pass the
+// difference of their moves. Fills hit and returns true when they meet within the
+// move, a move that ends touching the target counts. Boxes that already overlap at
+// the start are not a hit, resolve those by their intersection. On a corner the
+// vertical contact wins.
+bool SweepBox(const SDL_FRect& box, glm::vec2 delta, const SDL_FRect& target, SweepHit& hit);
+
+// everything box covers on its way to box + delta, what a broadphase has to look at
+inline SDL_FRect SweptBounds(const SDL_FRect& box, glm::vec2 delta)
+{
+    return {delta.x < 0.0f ? box.x + delta.x : box.x, delta.y < 0.0f ? box.y + delta.y : box.y,
+            box.w + (delta.x < 0.0f ? -delta.x : delta.x),
+            box.h + (delta.y < 0.0f ? -delta.y : delta.y)};
+}
@@ -0,0 +1,46 @@
+#include "threadPool.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#include <algorithm>
+
+#include "profiler.h"
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = static_cast<unsigned>(std::max(SDL_GetNumLogicalCPUCores() - 1, 1));
+
+    workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++)
+        workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    PROFILE_THREAD("ThreadPool worker");
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
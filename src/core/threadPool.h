@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads draining one FIFO of tasks. Meant for coarse jobs
+// such as decoding a file; the destructor finishes the queue before joining.
+class ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void WorkerLoop();
+
+   public:
+    // threadCount 0 picks one worker per logical core, minus the calling thread
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Fn>
+    auto Submit(Fn&& fn) -> std::future<decltype(fn())>
+    {
+        using Result = decltype(fn());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    size_t GetThreadCount() const { return workers.size(); }
+};
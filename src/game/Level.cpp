@@ -7,420 +7,659 @@
 #include <SDL3/SDL_render.h>
 
 #include <algorithm>
-#include <format>
 #include <glm/fwd.hpp>
 #include <memory>
+#include <span>
 
 #include "core/camera.h"
+#include "core/profiler.h"
 #include "core/resourceManager.h"
 #include "enemy.h"
+#include "entityStore.h"
 #include "game/bullet.h"
-#include "game/gameobject.h"
 #include "player.h"
 
-void Level::LoadMap(ResourceManager* res)
+// entities per job of the parallel update, a few microseconds of work each
+static const uint32_t ENTITY_GRAIN = 512;
+// solid tiles of a full view with margin, the overlay rarely regrows past it
+static const size_t DEBUG_RECT_RESERVE = 512;
+static const uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+// FNV-1a over size bytes, continuing from hash
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
 {
-    backgroundLayers.push_back({res->GetTexture("background_1"), 0.0f, 0});
-    backgroundLayers.push_back({res->GetTexture("background_2"), 0.5f, 220});
-    short map[MAP_ROWS][MAP_COLS] = {{0}};
-    short foreground[MAP_ROWS][MAP_COLS] = {{0}};
-    short background[MAP_ROWS][MAP_COLS] = {{0}};
-    this->SetMap(map, background, foreground);
-    camera = std::make_unique<Camera>(640, 320, MAP_COLS * TILE_SIZE, 320);
-    const auto load_map_layers = [res, this](short layer[MAP_ROWS][MAP_COLS])
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return hash;
+}
+
+bool Level::LoadMap(ResourceManager* res, const std::string& path, uint64_t seed)
+{
+    PROFILE_ZONE("Level::LoadMap");
+    if (!levelFile.Open(path))
     {
-        for (int r = 0; r < MAP_ROWS; r++)
+        std::string textPath = path.substr(0, path.rfind('.')) + ".txt";
+        if (!levelFile.OpenText(textPath))
         {
-            for (int c = 0; c < MAP_COLS; c++)
-            {
-                int type = layer[r][c];
-                if (type == 0)
-                    continue;
-
-                float x = c * TILE_SIZE;
-                float y = (320) - (MAP_ROWS - r) * TILE_SIZE;
-                if (type == 4)
-                {
-                    auto pl = std::make_unique<Player>(res->GetTexture("player"));
-                    pl->position = {x, y};
-                    pl->onShoot = [this, res](glm::vec2 pos, float dir)
-                    {
-                        bool found_bullet = false;
-                        for (int i = 0; i < (int)bullets.size() && !found_bullet; i++)
-                        {
-                            if (bullets[i].GetState() == BulletState::Inactive)
-                            {
-                                bullets[i].reset(pos, dir);
-                                found_bullet = true;
-                            }
-                        }
-                        if (!found_bullet)
-                        {
-                            Bullet b(res->GetTexture("bullet"), pos, dir);
-                            this->bullets.push_back(std::move(b));
-                        }
-                    };
-                    this->player = pl.get();
-                    pl->tag = GameObject::Tag::player;
-                    layers[LAYER_IDX_CHARACTERS].push_back(std::move(pl));
-                }
-                else if (type == 2)
-                {
-                    auto panel = std::make_unique<GameObject>();
-                    panel->texture = res->GetTexture("panel");
-                    panel->position = {x, y};
-                    panel->tag = GameObject::Tag::level;
-                    layers[LAYER_IDX_LEVEL].push_back(std::move(panel));
-                }
-                else if (type == 1)
-                {
-                    auto ground = std::make_unique<GameObject>();
-                    ground->texture = res->GetTexture("ground");
-                    ground->position = {x, y};
-                    ground->tag = GameObject::Tag::level;
-                    layers[LAYER_IDX_LEVEL].push_back(std::move(ground));
-                }
-                else if (type == 5)
-                {
-                    auto& grass = foregroundTiles.emplace_back();
-                    grass.texture = res->GetTexture("grass");
-                    grass.position = {x, y};
-                    grass.tag = GameObject::Tag::level;
-                }
-                else if (type == 6)
-                {
-                    auto& brick = backgroundTiles.emplace_back();
-                    brick.texture = res->GetTexture("brick");
-                    brick.position = {x, y};
-                    brick.tag = GameObject::Tag::level;
-                }
-                else if (type == 3)
-                {
-                    auto enemy = std::make_unique<Enemy>(res->GetTexture("enemy"));
-                    enemy->position = {x, y};
-                    layers[LAYER_IDX_CHARACTERS].push_back(std::move(enemy));
-                }
-            }
+            SDL_Log("Cannot load level %s", path.c_str());
+            return false;
         }
-    };
-    load_map_layers(map);
-    load_map_layers(foreground);
-    load_map_layers(background);
+        SDL_Log("Level %s converted from text, run --convert-level to skip this", path.c_str());
+    }
+    return Populate(res, path, seed);
+}
 
-    SDL_assert_release(this->player != nullptr && "No Player intialized check itup ");
+bool Level::LoadSource(ResourceManager* res, std::string_view text, uint64_t seed)
+{
+    PROFILE_ZONE("Level::LoadSource");
+    if (!levelFile.OpenSource(text, "(memory)"))
+        return false;
+    return Populate(res, "(memory)", seed);
 }
 
-void Level::Update(float deltaTime, const bool* keys)
+bool Level::Populate(ResourceManager* res, const std::string& name, uint64_t seed)
 {
-    for (auto& layer : layers)
+    rngState = seed;
+    const LevelHeader& header = levelFile.GetHeader();
+
+    // resolve every sheet once, spawning below only copies regions
+    const AtlasRegion& playerSheet = res->Get(res->Find(AssetName::Player));
+    enemySheet = res->Get(res->Find(AssetName::Enemy));
+    for (const LevelParallax& layer : levelFile.GetParallax())
+    {
+        backgroundLayers.push_back({res->Get(res->Find(layer.sprite)),
+                                    {layer.scrollSpeed, layer.scrollSpeedY},
+                                    layer.y,
+                                    (layer.repeat & LevelParallax::RepeatX) != 0,
+                                    (layer.repeat & LevelParallax::RepeatY) != 0});
+    }
+
+    tileSet.Register(1, {res->Get(res->Find(AssetName::Ground)), true});
+    tileSet.Register(2, {res->Get(res->Find(AssetName::Panel)), true});
+    tileSet.Register(5, {res->Get(res->Find(AssetName::Grass)), false});
+    tileSet.Register(6, {res->Get(res->Find(AssetName::Brick)), false});
+    // a bake draws at most one full chunk of a tile sheet between two flushes
+    for (NameHash tile : {AssetName::Ground, AssetName::Panel, AssetName::Grass, AssetName::Brick})
     {
-        for (auto& obj : layer)
+        spriteBatch.Reserve(res->Get(res->Find(tile)).texture,
+                            TileGrid::CHUNK_TILES * TileGrid::CHUNK_TILES);
+    }
+
+    // the grids work on the file's tile layers in place
+    int cols = static_cast<int>(header.cols);
+    int rows = static_cast<int>(header.rows);
+    glm::vec2 gridOrigin = {header.originX, header.originY};
+    backgroundGrid.AttachTiles(cols, rows, header.tileSize, gridOrigin, &tileSet,
+                               levelFile.GetLayer(LevelLayer::Background));
+    levelGrid.AttachTiles(cols, rows, header.tileSize, gridOrigin, &tileSet,
+                          levelFile.GetLayer(LevelLayer::Level));
+    foregroundGrid.AttachTiles(cols, rows, header.tileSize, gridOrigin, &tileSet,
+                               levelFile.GetLayer(LevelLayer::Foreground));
+    backgroundCache.Attach(&backgroundGrid);
+    levelCache.Attach(&levelGrid);
+    foregroundCache.Attach(&foregroundGrid);
+
+    SDL_FRect bounds = levelGrid.GetBounds();
+    camera = std::make_unique<Camera>(viewWidth, viewHeight,
+                                      static_cast<int>(bounds.x + bounds.w),
+                                      static_cast<int>(bounds.y + bounds.h));
+
+    const AtlasRegion& bulletSheet = res->Get(res->Find(AssetName::Bullet));
+    bullets.SetSheet(bulletSheet);
+    // the player exists for the whole level, everything else streams with its chunk
+    std::span<const LevelSpawn> spawns = levelFile.GetSpawns();
+    // every entity and a full bullet pool fit in the batch, so a fight does not grow it
+    uint32_t spriteCount = static_cast<uint32_t>(spawns.size()) + bullets.Capacity();
+    spriteBatch.Reserve(enemySheet.texture, spriteCount);
+    spriteBatch.Reserve(bulletSheet.texture, spriteCount);
+    spawnStatus.assign(spawns.size(), SpawnStatus::Pending);
+    // at most every spawn is alive at once, streaming chunks in then never grows the store
+    entities.Reserve(spawns.size());
+    bodyHash.Reserve(static_cast<uint32_t>(spawns.size()));
+    for (uint32_t i = 0; i < spawns.size(); i++)
+    {
+        if (spawns[i].kind != SpawnKind::Player)
+            continue;
+        SpawnPlayer(entities, player, playerSheet, {spawns[i].x, spawns[i].y});
+        player.onShoot = [this](glm::vec2 pos, float dir) { bullets.Spawn(pos, dir, rngState); };
+        entities.spawn[player.entity] = i;
+        spawnStatus[i] = SpawnStatus::Live;
+        break;
+    }
+    if (entities.Size() == 0)
+    {
+        SDL_Log("Level %s has no player spawn", name.c_str());
+        return false;
+    }
+
+    camera->Follow(entities.position[player.entity]);
+    camera->ResetInterpolation();
+    streamer.Attach(&levelGrid, &levelFile);
+    // an unloading chunk leaves the queue, so it never holds more than every chunk
+    bakeQueue.clear();
+    bakeQueue.reserve(static_cast<size_t>(levelGrid.GetChunkCols()) * levelGrid.GetChunkRows());
+    ReserveChunkTextures();
+    StreamChunks();
+    return true;
+}
+
+void Level::StreamChunks()
+{
+    PROFILE_ZONE("Level::StreamChunks");
+    for (const ChunkEvent& event : streamer.Update(camera->GetVisibleRect(1.0f)))
+    {
+        if (event.previous == ChunkState::Loading)
+        {
+            SpawnChunk(event.cx, event.cy);
+            if (streamer.GetTileCount(event.cx, event.cy) > 0)
+                bakeQueue.push_back({event.cx, event.cy});
+        }
+        else if (event.state == ChunkState::Unloaded)
         {
-            obj->update(deltaTime, keys);
+            std::erase_if(bakeQueue, [&](SDL_Point chunk)
+                          { return chunk.x == event.cx && chunk.y == event.cy; });
+            backgroundCache.Release(spriteBatch, event.cx, event.cy);
+            levelCache.Release(spriteBatch, event.cx, event.cy);
+            foregroundCache.Release(spriteBatch, event.cx, event.cy);
         }
     }
-    for (auto& obj : bullets)
+
+    // entities go by the chunk they are in now, which is not always the one they spawned in
+    for (uint32_t i = entities.Size(); i-- > 0;)
     {
-        obj.update(deltaTime, keys);
+        if (i == player.entity)
+            continue;
+        // a chunk still loading keeps what walks into it asleep, its own spawns come later
+        ChunkState state = streamer.GetState(streamer.ChunkAt(entities.position[i]));
+        if (state == ChunkState::Unloaded)
+            DespawnEntity(i);
+        else
+            entities.Set(i, EntityStore::Asleep, state != ChunkState::Active);
     }
+    stats.activeChunks = streamer.GetActiveCount();
+    stats.residentChunks = streamer.GetResidentCount();
+}
 
-    if (player)
+void Level::SpawnChunk(int cx, int cy)
+{
+    std::span<const LevelSpawn> spawns = levelFile.GetSpawns();
+    for (uint32_t i : streamer.GetSpawns(cx, cy))
     {
-        camera->Follow(player->position);
+        if (spawns[i].kind != SpawnKind::Enemy || spawnStatus[i] != SpawnStatus::Pending)
+            continue;
+        uint32_t e = SpawnEnemy(entities, enemySheet, {spawns[i].x, spawns[i].y});
+        entities.spawn[e] = i;
+        spawnStatus[i] = SpawnStatus::Live;
+    }
+}
+
+void Level::DespawnEntity(uint32_t i)
+{
+    uint32_t spawn = entities.spawn[i];
+    if (spawn != EntityStore::NoSpawn)
+    {
+        bool dead = entities.tag[i] == EntityTag::enemy &&
+                    entities.state[i] == static_cast<uint8_t>(EnemyState::Dead);
+        spawnStatus[spawn] = dead ? SpawnStatus::Cleared : SpawnStatus::Pending;
+    }
+    if (entities.Destroy(i) == player.entity)
+        player.entity = i;
+}
+
+void Level::Update(float deltaTime, const InputState& input)
+{
+    PROFILE_ZONE("Level::Update");
+    uint64_t phaseStart = SDL_GetTicksNS();
+
+    StreamChunks();
+    {
+        PROFILE_ZONE("Level::UpdateEntities");
+        // remember where everything was so Render can interpolate into this tick
+        SnapshotPositions(entities);
+        bullets.SnapshotPositions();
+
+        // shooting spawns bullets and draws from the RNG, so the player goes first, here
+        UpdatePlayer(entities, player, deltaTime, input);
+
+        // Enemies and bullets do not read each other while they move. Each entity range
+        // only touches its own indices and the bullets stay in one job, so the tick
+        // comes out the same as a serial pass whatever the thread count.
+        JobHandle bodies = jobs.ParallelFor(
+            entities.Size(), ENTITY_GRAIN,
+            [this, deltaTime](uint32_t begin, uint32_t end)
+            {
+                PROFILE_ZONE("UpdateEntityRange");
+                UpdateEnemies(entities, deltaTime, begin, end);
+                IntegrateBodies(entities, deltaTime, begin, end);
+                StepAnimations(entities, deltaTime, begin, end);
+            });
+        // nothing outside the active chunks is simulated, bullets leaving them are retired
+        SDL_FRect bounds = streamer.GetActiveBounds();
+        JobHandle retired = jobs.Schedule(
+            [this, bounds]
+            {
+                PROFILE_ZONE("BulletPool::Retire");
+                bullets.Retire(bounds.x, bounds.x + bounds.w);
+            });
+        JobHandle shots = jobs.Schedule(
+            [this, deltaTime]
+            {
+                PROFILE_ZONE("BulletPool::Integrate");
+                bullets.Integrate(deltaTime);
+            },
+            {retired});
+        jobs.Wait(bodies);
+        jobs.Wait(shots);
+
+        camera->Follow(entities.position[player.entity]);
     }
 
+    uint64_t collisionStart = SDL_GetTicksNS();
+    stats.updateNs = collisionStart - phaseStart;
+
     // Check Physics
-    CheckCollisions(deltaTime);
+    CheckCollisions();
+    uint64_t groundStart = SDL_GetTicksNS();
+    stats.collisionNs = groundStart - collisionStart;
+
     UpdateGroundState();
+    stats.groundNs = SDL_GetTicksNS() - groundStart;
+    stats.entityCount = entities.Size();
+    stats.bulletCount = bullets.ActiveCount();
 }
 
-void Level::Render(SDL_Renderer* renderer, bool debugMode)
+void Level::Render(SDL_Renderer* renderer, bool debugMode, float alpha)
 {
-    ParallaxBackgroundDraw(renderer);
-    for (auto& obj : backgroundTiles)
+    PROFILE_ZONE("Level::Render");
+    uint64_t renderStart = SDL_GetTicksNS();
+    glm::vec2 offset = camera->GetOffset(alpha);
+    spriteBatch.ResetStats();
+    // one streamed-in chunk per frame gets its textures before it scrolls into view
+    while (!bakeQueue.empty())
     {
-        obj.Render(renderer, camera->GetOffset());
+        SDL_Point chunk = bakeQueue.back();
+        bakeQueue.pop_back();
+        if (streamer.GetState(chunk) == ChunkState::Unloaded)
+            continue;
+        backgroundCache.Prebake(renderer, spriteBatch, chunk.x, chunk.y);
+        levelCache.Prebake(renderer, spriteBatch, chunk.x, chunk.y);
+        foregroundCache.Prebake(renderer, spriteBatch, chunk.x, chunk.y);
+        break;
     }
-    for (int i = 0; i < this->TOTAL_LAYERS; i++)
+    ParallaxBackgroundDraw(offset);
+    spriteBatch.Flush(renderer);
+    SDL_FRect view = camera->GetVisibleRect(alpha);
+    CullStats cull;
+    backgroundCache.Render(renderer, spriteBatch, view, offset, cull);
+    spriteBatch.Flush(renderer);
+    levelCache.Render(renderer, spriteBatch, view, offset, cull);
+    spriteBatch.Flush(renderer);
+    if (debugMode)
     {
-        for (auto& obj : layers[i])
-        {
-            obj->Render(renderer, camera->GetOffset());
-
-            if (debugMode)
-            {
-                SDL_FRect rectA = {obj->position.x + obj->collider.x + camera->GetOffset().x,
-                                   obj->position.y + obj->collider.y + camera->GetOffset().y,
-                                   obj->collider.w, obj->collider.h};
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
-                SDL_RenderFillRect(renderer, &rectA);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-            }
-        }
+        // only the solid cells under the view, collected in frame scratch memory
+        ScratchScope scratch(frameArena);
+        ArenaVector<SDL_FRect> debugRects{ArenaAllocator<SDL_FRect>(frameArena)};
+        debugRects.reserve(DEBUG_RECT_RESERVE);
+        levelGrid.ForEachSolidTile(view,
+                                   [&](SDL_FRect tileRect)
+                                   {
+                                       tileRect.x += offset.x;
+                                       tileRect.y += offset.y;
+                                       debugRects.push_back(tileRect);
+                                   });
+        DrawDebugRects(renderer, debugRects);
     }
-    for (auto& obj : bullets)
+    RenderEntities(entities, spriteBatch, view, offset, alpha, cull);
+    bullets.Render(spriteBatch, view, offset, alpha, cull);
+    spriteBatch.Flush(renderer);
+    if (debugMode)
     {
-        if (obj.GetState() == BulletState::Inactive)
-            continue;
-        obj.Render(renderer, camera->GetOffset());
-        if (debugMode)
+        ScratchScope scratch(frameArena);
+        ArenaVector<SDL_FRect> debugRects{ArenaAllocator<SDL_FRect>(frameArena)};
+        debugRects.reserve(entities.Size() + bullets.ActiveCount());
+        for (uint32_t i = 0; i < entities.Size(); i++)
         {
-            SDL_FRect rectA = {obj.position.x + obj.collider.x + camera->GetOffset().x,
-                               obj.position.y + obj.collider.y + camera->GetOffset().y,
-                               obj.collider.w, obj.collider.h};
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
-            SDL_RenderFillRect(renderer, &rectA);
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            if (!entities.Has(i, EntityStore::Visible) || entities.Has(i, EntityStore::Asleep))
+                continue;
+            glm::vec2 pos = entities.GetRenderPosition(i, alpha);
+            const SDL_FRect& box = entities.collider[i];
+            SDL_FRect rectA = {pos.x + box.x, pos.y + box.y, box.w, box.h};
+            if (!Camera::IsVisible(view, rectA))
+                continue;
+            debugRects.push_back({rectA.x + offset.x, rectA.y + offset.y, box.w, box.h});
         }
+        for (uint32_t i = 0; i < bullets.ActiveCount(); i++)
+        {
+            glm::vec2 pos = bullets.GetRenderPosition(i, alpha);
+            const SDL_FRect& box = BulletPool::Collider;
+            SDL_FRect rectA = {pos.x + box.x, pos.y + box.y, box.w, box.h};
+            if (!Camera::IsVisible(view, rectA))
+                continue;
+            debugRects.push_back({rectA.x + offset.x, rectA.y + offset.y, box.w, box.h});
+        }
+        DrawDebugRects(renderer, debugRects);
     }
-    for (auto& obj : foregroundTiles)
-    {
-        obj.Render(renderer, camera->GetOffset());
-    }
+    foregroundCache.Render(renderer, spriteBatch, view, offset, cull);
+    spriteBatch.Flush(renderer);
+    stats.drawCalls = spriteBatch.GetStats().drawCalls;
+    stats.spriteQuads = spriteBatch.GetStats().quads;
+    stats.visibleSprites = cull.visible;
+    stats.culledSprites = cull.culled;
     if (debugMode)
     {
+        // formatted on the stack, the overlay must not show up in the allocation count
+        char text[96];
+        SDL_snprintf(text, sizeof(text), "S:%d G:%d B:%u P:%llu D:%u Q:%u V:%u C:%u",
+                     static_cast<int>(player.state),
+                     entities.Has(player.entity, EntityStore::Grounded), bullets.ActiveCount(),
+                     static_cast<unsigned long long>(stats.pairsTested), stats.drawCalls,
+                     stats.spriteQuads, stats.visibleSprites, stats.culledSprites);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDebugText(renderer, 5, 5,
-                            std::format("S:{} G:{} B:{}", static_cast<int>(player->getState()),
-                                        player->isGrounded(), bullets.size())
-                                .c_str());
+        SDL_RenderDebugText(renderer, 5, 5, text);
     }
+    stats.renderNs = SDL_GetTicksNS() - renderStart;
 }
 
-void Level::ParallaxBackgroundDraw(SDL_Renderer* renderer)
+void Level::DrawDebugRects(SDL_Renderer* renderer, const ArenaVector<SDL_FRect>& rects)
 {
-    float screenW = 640.0f;
-
-    float camX = -camera->GetOffset().x;
+    // one state change and one draw call for the whole overlay pass
+    if (!rects.empty())
+    {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
+        SDL_RenderFillRects(renderer, rects.data(), static_cast<int>(rects.size()));
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+}
 
-    for (const auto& layer : backgroundLayers)
+void Level::ParallaxBackgroundDraw(glm::vec2 offset)
+{
+    PROFILE_ZONE("Level::ParallaxBackgroundDraw");
+    const float screenW = static_cast<float>(viewWidth);
+    const float screenH = static_cast<float>(viewHeight);
+    for (const ParallaxLayer& layer : backgroundLayers)
     {
-        if (!layer.texture)
+        const SDL_FRect& src = layer.sprite.rect;
+        if (!layer.sprite.texture || src.w <= 0 || src.h <= 0)
             continue;
 
-        float w, h;
-        SDL_GetTextureSize(layer.texture, &w, &h);
-
-        float boundary_position_x = -std::fmod(camX * layer.scrollSpeed, w);
-
-        if (boundary_position_x > 0)
+        // a repeating axis starts at the copy that crosses the screen edge and repeats
+        // to the far edge. The copies are quads of the atlas region in the batch, so the
+        // layers on one atlas page go out as one geometry call
+        SDL_FRect area = {offset.x * layer.scrollSpeed.x,
+                          layer.yposition + offset.y * layer.scrollSpeed.y, src.w, src.h};
+        if (layer.repeatX)
         {
-            boundary_position_x = boundary_position_x - w;
+            area.x = std::fmod(area.x, src.w);
+            if (area.x > 0)
+                area.x -= src.w;
+            area.w = screenW - area.x;
         }
+        if (layer.repeatY)
+        {
+            area.y = std::fmod(area.y, src.h);
+            if (area.y > 0)
+                area.y -= src.h;
+            area.h = screenH - area.y;
+        }
+        if (area.x >= screenW || area.y >= screenH || area.x + area.w <= 0 ||
+            area.y + area.h <= 0)
+            continue;
 
-        float current_x_pos = boundary_position_x;
-
-        while (current_x_pos < screenW)
+        for (float y = area.y; y < area.y + area.h; y += src.h)
         {
-            SDL_FRect dst = {current_x_pos, layer.yposition, w, h};
-            SDL_RenderTexture(renderer, layer.texture, nullptr, &dst);
-            current_x_pos += w;
+            for (float x = area.x; x < area.x + area.w; x += src.w)
+                spriteBatch.Draw(layer.sprite.texture, &src, {x, y, src.w, src.h});
         }
     }
 }
 
-void Level::CheckCollisions(float deltaTime)
+void Level::SetViewSize(int width, int height)
 {
-    for (auto& tile : layers[LAYER_IDX_LEVEL])
+    viewWidth = width;
+    viewHeight = height;
+    if (camera)
     {
-        for (auto& character : layers[LAYER_IDX_CHARACTERS])
-        {
-            if (!character->dynamic)
-                continue;
+        camera->SetSize(static_cast<float>(width), static_cast<float>(height));
+        camera->Follow(entities.position[player.entity]);
+        camera->ResetInterpolation();
+        ReserveChunkTextures();
+    }
+}
 
-            SDL_FRect rectA = {character->position.x + character->collider.x,
-                               character->position.y + character->collider.y, character->collider.w,
-                               character->collider.h};
-            SDL_FRect rectB = {tile->position.x + tile->collider.x,
-                               tile->position.y + tile->collider.y, tile->collider.w,
-                               tile->collider.h};
-            SDL_FRect intersection;
+void Level::ReserveChunkTextures()
+{
+    // each tile layer bakes one texture per resident chunk
+    uint32_t needed = LEVEL_LAYER_COUNT * streamer.GetMaxResident(static_cast<float>(viewWidth),
+                                                                  static_cast<float>(viewHeight));
+    if (needed <= chunkTextureRoom)
+        return;
+    spriteBatch.ReserveTextures(needed - chunkTextureRoom);
+    chunkTextureRoom = needed;
+}
 
-            if (SDL_GetRectIntersectionFloat(&rectA, &rectB, &intersection))
-            {
-                ResolveCollision(*character, *tile, deltaTime, intersection);
-            }
-        }
-        for (auto& b : bullets)
-        {
-            if (b.GetState() == BulletState::Inactive)
-            {
-                continue;
-            }
-            else
+void Level::CheckCollisions()
+{
+    PROFILE_ZONE("Level::CheckCollisions");
+    // Movers vs tiles: swept along this tick's move, so a fast body stops at the first
+    // tile on its path instead of tunnelling through a thin one
+    const uint32_t count = entities.Size();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!entities.Has(i, EntityStore::Dynamic) || entities.Has(i, EntityStore::Asleep))
+            continue;
+
+        // a body that began the tick inside a tile (spawned or pushed there) is pushed
+        // out along its shallower overlap
+        if (!SweepBody(i))
+            continue;
+        levelGrid.ForEachSolidTile(
+            entities.GetWorldCollider(i),
+            [&](const SDL_FRect& tileRect)
             {
-                SDL_FRect rectA = {b.position.x + b.collider.x, b.position.y + b.collider.y,
-                                   b.collider.w, b.collider.h};
-                SDL_FRect rectB = {tile->position.x + tile->collider.x,
-                                   tile->position.y + tile->collider.y, tile->collider.w,
-                                   tile->collider.h};
+                // re-read the collider, earlier tiles may have pushed the entity
+                SDL_FRect rectA = entities.GetWorldCollider(i);
                 SDL_FRect intersection;
-                if (SDL_GetRectIntersectionFloat(&rectA, &rectB, &intersection))
+                if (SDL_GetRectIntersectionFloat(&rectA, &tileRect, &intersection) &&
+                    intersection.w > SWEEP_SKIN && intersection.h > SWEEP_SKIN)
                 {
-                    ResolveCollision(b, *tile, deltaTime, intersection);
-                    b.SetState(BulletState::Colliding);
+                    OnTileContact(i, ResolveTileOverlap(entities.position[i],
+                                                        entities.velocity[i], intersection));
                 }
-            }
-        }
+            });
     }
-    // Bullets vs Enemies
-    for (auto& b : bullets)
+
+    // Bullets vs Enemies: enemies go into the broadphase with the box they cover over
+    // the tick, each bullet only sweeps against the bodies sharing its cells
+    bodyHash.Clear();
+    for (uint32_t i = 0; i < count; i++)
     {
-        if (b.GetState() == BulletState::Inactive)
+        if (entities.tag[i] != EntityTag::enemy ||
+            entities.state[i] == static_cast<uint8_t>(EnemyState::Dead) ||
+            entities.Has(i, EntityStore::Asleep))
             continue;
 
-        SDL_FRect bRect = {b.position.x + b.collider.x, b.position.y + b.collider.y, b.collider.w,
-                           b.collider.h};
-        for (auto& character : layers[LAYER_IDX_CHARACTERS])
-        {
-            if (character->tag == GameObject::Tag::enemy)
-            {
-                Enemy* enemy = static_cast<Enemy*>(character.get());
-                if (enemy->getState() == EnemyState::Dead)
-                    continue;
+        glm::vec2 start = entities.prevPosition[i];
+        const SDL_FRect& box = entities.collider[i];
+        bodyHash.Insert(i, SweptBounds({start.x + box.x, start.y + box.y, box.w, box.h},
+                                       entities.position[i] - start));
+    }
+    bodyHash.Build();
 
-                SDL_FRect eRect = {enemy->position.x + enemy->collider.x,
-                                   enemy->position.y + enemy->collider.y, enemy->collider.w,
-                                   enemy->collider.h};
-                SDL_FRect intersection;
+    for (uint32_t b = 0; b < bullets.ActiveCount(); b++)
+    {
+        // bullets playing their impact already hit something
+        if (bullets.state[b] != BulletState::Moving)
+            continue;
 
-                if (SDL_GetRectIntersectionFloat(&bRect, &eRect, &intersection))
-                {
-                    enemy->takeDamage();
-                    b.SetState(BulletState::Colliding);
-                }
-            }
+        glm::vec2 start = {bullets.prevX[b], bullets.prevY[b]};
+        glm::vec2 delta = glm::vec2{bullets.posX[b], bullets.posY[b]} - start;
+        const SDL_FRect& collider = BulletPool::Collider;
+        SDL_FRect box = {start.x + collider.x, start.y + collider.y, collider.w, collider.h};
+
+        SweepHit hit = levelGrid.SweepSolid(box, delta);
+        bool collided = hit.IsHit();
+        // a bullet fired from inside a wall hits it right away
+        if (!collided && levelGrid.OverlapsSolid(box))
+        {
+            hit.time = 0.0f;
+            collided = true;
         }
+
+        // the enemy met before the wall, if any, moving enemies sweep relative to the bullet
+        uint32_t victim = count;
+        bodyHash.Query(SweptBounds(box, delta),
+                       [&](uint32_t id, const SDL_FRect&)
+                       {
+                           if (entities.state[id] == static_cast<uint8_t>(EnemyState::Dead))
+                               return;
+                           glm::vec2 enemyStart = entities.prevPosition[id];
+                           const SDL_FRect& eBox = entities.collider[id];
+                           SDL_FRect eRect = {enemyStart.x + eBox.x, enemyStart.y + eBox.y,
+                                              eBox.w, eBox.h};
+                           SweepHit enemyHit;
+                           if (SDL_HasRectIntersectionFloat(&box, &eRect))
+                               enemyHit.time = 0.0f;
+                           else if (!SweepBox(box, delta - (entities.position[id] - enemyStart),
+                                              eRect, enemyHit))
+                               return;
+                           if (!collided || enemyHit.time < hit.time)
+                           {
+                               hit = enemyHit;
+                               victim = id;
+                               collided = true;
+                           }
+                       });
+        if (!collided)
+            continue;
+
+        if (victim < count)
+            DamageEnemy(entities, victim);
+        // the impact plays where the bullet met the surface
+        bullets.posX[b] = start.x + delta.x * hit.time;
+        bullets.posY[b] = start.y + delta.y * hit.time;
+        bullets.SetState(b, BulletState::Colliding);
     }
+    stats.pairsTested = bodyHash.GetPairsTested();
 }
-void Level::ResolveCollision(GameObject& a, GameObject& b, float deltaTime, SDL_FRect intersection)
+
+bool Level::SweepBody(uint32_t i)
 {
-    if ((a.tag == GameObject::Tag::player || a.tag == GameObject::Tag::bullet ||
-         a.tag == GameObject::Tag::enemy) &&
-        b.tag == GameObject::Tag::level)
+    // from where the body started the tick to where it integrated to, sliding along
+    // every tile it meets; a move that hits nothing leaves the position alone
+    glm::vec2 position = entities.prevPosition[i];
+    glm::vec2 delta = entities.position[i] - position;
+    const SDL_FRect& box = entities.collider[i];
+    bool blocked = false;
+    // a body that did not move is checked by overlap, to be safe
+    bool startsInside = delta.x == 0.0f && delta.y == 0.0f;
+    // every hit stops one axis, so two slides use up the move
+    for (int slide = 0; slide < 2 && (delta.x != 0.0f || delta.y != 0.0f); slide++)
     {
-        // Horizontal Collision
-        if (intersection.w < intersection.h)
+        SDL_FRect start = {position.x + box.x, position.y + box.y, box.w, box.h};
+        SweepHit hit = levelGrid.SweepSolid(start, delta, slide == 0 ? &startsInside : nullptr);
+        if (!hit.IsHit())
+            break;
+
+        blocked = true;
+        position += delta * hit.time;
+        delta *= 1.0f - hit.time;
+        TileContact contact;
+        if (hit.normal.x != 0.0f)
         {
-            if (a.velocity.x > 0)
-                a.position.x -= intersection.w;
-            else if (a.velocity.x < 0)
-                a.position.x += intersection.w;
-            a.velocity.x = 0;
-
-            // Reversing the enemy if it hits a wall sideways
-            if (a.tag == GameObject::Tag::enemy)
-            {
-                static_cast<Enemy*>(&a)->reverseDirection();
-            }
+            delta.x = 0.0f;
+            entities.velocity[i].x = 0.0f;
+            contact = TileContact::Side;
         }
-        // Vertical Collision
         else
         {
-            if (a.velocity.y > 0)
-            {
-                a.position.y -= intersection.h;
-                a.velocity.y = 0;
-                if (a.tag == GameObject::Tag::player)
-                    static_cast<Player*>(&a)->setGrounded(true);
-                if (a.tag == GameObject::Tag::enemy)
-                    static_cast<Enemy*>(&a)->setGrounded(true);
-            }
-            else if (a.velocity.y < 0)
-            {
-                a.position.y += intersection.h;
-                a.velocity.y = 0;
-            }
+            delta.y = 0.0f;
+            entities.velocity[i].y = 0.0f;
+            contact = hit.normal.y < 0.0f ? TileContact::Floor : TileContact::Ceiling;
         }
+        OnTileContact(i, contact);
     }
+    if (blocked)
+        entities.position[i] = position + delta;
+    return startsInside;
 }
-void Level::SetMap(short map[MAP_ROWS][MAP_COLS], short background[MAP_ROWS][MAP_COLS],
-                   short foreground[MAP_ROWS][MAP_COLS])
-{
-    /*
-     * 1.Ground
-     * 2.Panel
-     * 3.Enemy
-     * 4.Player
-     * 5.Grass
-     * 6.Brick
-     */
-
-    for (int j = 0; j < MAP_COLS; j++)
-    {
-        map[4][j] = 1;
-        background[4][j] = 6;
-        if (j % 5 == 0)
-        {
-            background[3][j] = 6;
-            background[2][j] = 6;
-        }
-    }
 
-    for (int j = 15; j < 20; j++)
+void Level::OnTileContact(uint32_t a, TileContact contact)
+{
+    EntityTag tag = entities.tag[a];
+    // Reversing the enemy if it hits a wall sideways
+    if (contact == TileContact::Side && tag == EntityTag::enemy)
     {
-        map[4][j] = 0;
+        ReverseEnemy(entities, a);
     }
-
-    map[2][16] = 2;
-    map[2][18] = 2;
-    map[3][30] = 2;
-    map[2][31] = 2;
-
-    map[2][32] = map[2][33] = map[2][34] = 2;
-
-    map[3][35] = 2;
-    map[3][48] = 1;
-    map[2][48] = 1;
-
-    for (int i = 1; i < MAP_ROWS; i++)
+    else if (contact == TileContact::Floor &&
+             (tag == EntityTag::player || tag == EntityTag::enemy))
     {
-        for (int j = 0; j < MAP_COLS; j++)
-        {
-            if (map[i][j] == 1 || map[i][j] == 2)
-            {
-                foreground[i - 1][j] = 0;
-            }
-        }
+        entities.Set(a, EntityStore::Grounded, true);
     }
-
-    map[3][2] = 4;
-    map[3][25] = 3;
-    map[3][28] = 3;
 }
 
 void Level::UpdateGroundState()
 {
-    if (player->velocity.y < 0)
+    PROFILE_ZONE("Level::UpdateGroundState");
+    const uint32_t i = player.entity;
+    if (entities.velocity[i].y < 0)
     {
-        player->setGrounded(false);
+        entities.Set(i, EntityStore::Grounded, false);
         return;
     }
 
     float sensorDist = 2.0f;
-    SDL_FRect sensor = {player->position.x + player->collider.x + 1,
-                        player->position.y + player->collider.y + player->collider.h,
-                        player->collider.w - 2, sensorDist};
+    SDL_FRect box = entities.GetWorldCollider(i);
+    SDL_FRect sensor = {box.x + 1, box.y + box.h, box.w - 2, sensorDist};
 
-    SDL_FRect intersection;
-    bool hitGround = false;
-    for (auto& tile : layers[LAYER_IDX_LEVEL])
-    {
-        SDL_FRect tileRect = {tile->position.x + tile->collider.x,
-                              tile->position.y + tile->collider.y, tile->collider.w,
-                              tile->collider.h};
+    bool hitGround = levelGrid.OverlapsSolid(sensor);
 
-        if (SDL_GetRectIntersectionFloat(&tileRect, &sensor, &intersection))
-        {
-            hitGround = true;
-            break;
-        }
+    if (hitGround)
+    {
+        entities.Set(i, EntityStore::Grounded, true);
     }
+}
 
-    if (hitGround)
+void Level::InvalidateRenderCache()
+{
+    backgroundCache.Invalidate();
+    levelCache.Invalidate();
+    foregroundCache.Invalidate();
+}
+
+uint64_t Level::ComputeChecksum() const
+{
+    // Sleeping entities are left out: whether a chunk in the load ring is resident yet
+    // depends on the loader thread, and nothing there moves until it turns active.
+    // Store order depends on it too, so entity hashes are summed instead of chained.
+    uint64_t entitySum = 0;
+    for (uint32_t i = 0; i < entities.Size(); i++)
     {
-        player->setGrounded(true);
+        if (entities.Has(i, EntityStore::Asleep))
+            continue;
+        uint64_t hash = HashBytes(FNV_OFFSET, &entities.spawn[i], sizeof(uint32_t));
+        hash = HashBytes(hash, &entities.position[i], sizeof(glm::vec2));
+        hash = HashBytes(hash, &entities.velocity[i], sizeof(glm::vec2));
+        hash = HashBytes(hash, &entities.flags[i], sizeof(uint8_t));
+        hash = HashBytes(hash, &entities.state[i], sizeof(uint8_t));
+        hash = HashBytes(hash, &entities.direction[i], sizeof(float));
+        entitySum += hash;
     }
+
+    uint64_t hash = HashBytes(FNV_OFFSET, &entitySum, sizeof(entitySum));
+    hash = HashBytes(hash, &rngState, sizeof(rngState));
+    float weaponTime = player.weaponTimer.getTime();
+    hash = HashBytes(hash, &weaponTime, sizeof(weaponTime));
+    hash = HashBytes(hash, &player.autoFireDue, sizeof(player.autoFireDue));
+    // the pool's dense order only depends on the order of spawns and despawns
+    const uint32_t live = bullets.ActiveCount();
+    hash = HashBytes(hash, &live, sizeof(live));
+    hash = HashBytes(hash, bullets.posX.data(), live * sizeof(float));
+    hash = HashBytes(hash, bullets.posY.data(), live * sizeof(float));
+    hash = HashBytes(hash, bullets.velX.data(), live * sizeof(float));
+    hash = HashBytes(hash, bullets.velY.data(), live * sizeof(float));
+    hash = HashBytes(hash, bullets.state.data(), live * sizeof(BulletState));
+    return hash;
 }
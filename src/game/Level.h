@@ -1,50 +1,147 @@
 #pragma once
 #include <SDL3/SDL_rect.h>
 
-#include <array>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "assetNames.h"
 #include "bullet.h"
+#include "chunkStreamer.h"
 #include "core/camera.h"
+#include "core/frameArena.h"
+#include "core/input.h"
+#include "core/jobSystem.h"
 #include "core/resourceManager.h"
+#include "core/spatialHash.h"
+#include "core/spriteBatch.h"
 #include "enemy.h"
 #include "game/player.h"
-#include "gameobject.h"
+#include "entityStore.h"
+#include "levelFile.h"
+#include "tileGrid.h"
+#include "tileLayerCache.h"
 
+// a background image drawn behind the tiles, scrolling slower than the level
 struct ParallaxLayer
 {
-    SDL_Texture* texture;
-    float scrollSpeed{0.0f};  // 0.0 static backgorund render , and 1,0 player moves
+    AtlasRegion sprite;
+    glm::vec2 scrollSpeed{0.0f};  // 0.0 static backgorund render , and 1,0 player moves
     float yposition = 0;
+    bool repeatX = true;
+    bool repeatY = false;
+};
+
+struct LevelStats
+{
+    uint64_t pairsTested = 0;  // dynamic-vs-dynamic narrowphase tests in the last tick
+    // wall time of each phase for the last tick / rendered frame, in nanoseconds
+    uint64_t updateNs = 0;
+    uint64_t collisionNs = 0;
+    uint64_t groundNs = 0;
+    uint64_t renderNs = 0;
+    // sprite submissions of the last rendered frame
+    uint32_t drawCalls = 0;
+    uint32_t spriteQuads = 0;
+    // chunks and sprites that passed / failed the camera visibility test
+    uint32_t visibleSprites = 0;
+    uint32_t culledSprites = 0;
+    // streamed chunks after the last tick, resident counts the active ones too
+    uint32_t activeChunks = 0;
+    uint32_t residentChunks = 0;
+    // live entities (player and enemies) and bullets after the last tick
+    uint32_t entityCount = 0;
+    uint32_t bulletCount = 0;
 };
 
 class Level
 {
    private:
-    // layers background , player and blocks
-    static const int LAYER_IDX_LEVEL = 0;
-    static const int LAYER_IDX_CHARACTERS = 1;
-    static const int TOTAL_LAYERS = 2;
+    // shared with the application, the entity update fans out over it
+    JobSystem& jobs;
+    // reset by the application every frame, scratch lists of Render live here
+    FrameArena& frameArena;
     std::unique_ptr<Camera> camera;
-    Player* player = nullptr;
-    std::array<std::vector<std::unique_ptr<GameObject>>, TOTAL_LAYERS> layers;
-    std::vector<GameObject> backgroundTiles;
-    std::vector<GameObject> foregroundTiles;
-    std::vector<Bullet> bullets;
+    // backing storage of the tile grids, kept open for the lifetime of the level
+    LevelFile levelFile;
+    // decides which part of the level exists, declared after levelFile so its loader
+    // thread is gone before the file is unmapped
+    ChunkStreamer streamer;
+    // what happened to each entry of the spawn table, so a chunk that streams back in
+    // neither duplicates a wandering enemy nor revives a dead one
+    enum class SpawnStatus : uint8_t
+    {
+        Pending,
+        Live,
+        Cleared,
+    };
+    std::vector<SpawnStatus> spawnStatus;
+    // chunks that streamed in and still need their tile textures, one is baked per frame
+    std::vector<SDL_Point> bakeQueue;
+    // every player, enemy and bullet lives in the store, the player also has a controller
+    EntityStore entities;
+    PlayerController player;
+    BulletPool bullets;
+    // static tiles: background and foreground are decoration, levelGrid is solid geometry
+    TileSet tileSet;
+    TileGrid backgroundGrid;
+    TileGrid levelGrid;
+    TileGrid foregroundGrid;
+    // baked chunks of the three grids, the tiles never change after LoadMap
+    TileLayerCache backgroundCache;
+    TileLayerCache levelCache;
+    TileLayerCache foregroundCache;
     std::vector<ParallaxLayer> backgroundLayers;
-    static const int MAP_ROWS = 5;
-    static const int MAP_COLS = 50;
-    static const int TILE_SIZE = 32;
-    void CheckCollisions(float deltaTime);
-    void ResolveCollision(GameObject& a, GameObject& b, float deltaTime, SDL_FRect intersection);
+    // broadphase for dynamic-vs-dynamic checks, rebuilt every tick
+    SpatialHash bodyHash;
+    // every sprite of a frame goes through here, flushed once per layer
+    SpriteBatch spriteBatch;
+    LevelStats stats;
+    // resolved once in LoadMap, enemies spawn whenever their chunk streams in
+    AtlasRegion enemySheet;
+    // SDL_rand_r state of everything random in the simulation, seeded by LoadMap
+    uint64_t rngState = 0;
+    // logical size of the screen the camera fills
+    int viewWidth = 640;
+    int viewHeight = 320;
+    // sprite batch buckets set aside for chunk textures so far
+    uint32_t chunkTextureRoom = 0;
+    // everything loading does once levelFile is open, name labels the log messages
+    bool Populate(ResourceManager* res, const std::string& name, uint64_t seed);
+    void StreamChunks();
+    // makes room in the sprite batch for the chunk textures of the current view size
+    void ReserveChunkTextures();
+    void SpawnChunk(int cx, int cy);
+    void DespawnEntity(uint32_t i);
+    void CheckCollisions();
+    // true when the body began the tick inside a tile, the sweep can not push it out
+    bool SweepBody(uint32_t i);
+    void OnTileContact(uint32_t a, TileContact contact);
+    void DrawDebugRects(SDL_Renderer* renderer, const ArenaVector<SDL_FRect>& rects);
+    // queues the copies of every background layer that cover the view into the batch
+    void ParallaxBackgroundDraw(glm::vec2 offset);
 
    public:
-    void LoadMap(ResourceManager* res);
-    void Update(float deltaTime, const bool* keys);
-    void Render(SDL_Renderer* renderer, bool debugMode);
-    void ParallaxBackgroundDraw(SDL_Renderer* renderer);
-    void SetMap(short map[MAP_ROWS][MAP_COLS], short background[MAP_ROWS][MAP_COLS],
-                short foreground[MAP_ROWS][MAP_COLS]);
+    Level(JobSystem& jobSystem, FrameArena& frameArena) : jobs(jobSystem), frameArena(frameArena)
+    {
+    }
+    // loads a binary level, or its .txt source next to it when there is no binary yet.
+    // The same seed and the same input every tick replay the same run.
+    bool LoadMap(ResourceManager* res, const std::string& path, uint64_t seed);
+    // builds the level from level text in memory, e.g. a generated scene
+    bool LoadSource(ResourceManager* res, std::string_view text, uint64_t seed);
+    void Update(float deltaTime, const InputState& input);
+    // alpha blends entities between the previous and the current tick
+    void Render(SDL_Renderer* renderer, bool debugMode, float alpha);
     void UpdateGroundState();
+    // rebake every tile chunk, their textures are lost when render targets reset
+    void InvalidateRenderCache();
+    // logical render size, the camera view and the parallax cover this much
+    void SetViewSize(int width, int height);
+    // the player fires shotsPerSecond on its own, 0 turns it off
+    void SetAutoFire(float shotsPerSecond) { player.autoFireRate = shotsPerSecond; }
+    const LevelStats& GetStats() const { return stats; }
+    // hash of the simulation state (bodies, bullets, RNG), equal for equal runs
+    uint64_t ComputeChecksum() const;
 };
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+#include "core/animation.h"
+
+// every clip in the game, AnimationState::clip is an index into AnimationClips
+enum class ClipId : uint8_t
+{
+    PlayerIdle,
+    PlayerRun,
+    PlayerJump,
+    PlayerSlide,
+    EnemyWalk,
+    BulletFlying,
+    BulletImpact,
+};
+
+inline constexpr AnimationClip AnimationClips[] = {
+    MakeClip(4, 0.6f, 2, 32, 32),  // PlayerIdle
+    MakeClip(8, 1.2f, 3, 32, 32),  // PlayerRun
+    MakeClip(8, 1.2f, 5, 32, 32),  // PlayerJump
+    MakeClip(2, 0.3f, 0, 32, 32),  // PlayerSlide
+    MakeClip(4, 0.8f, 0, 32, 32),  // EnemyWalk
+    MakeClip(4, 0.6f, 0, 16, 16),  // BulletFlying
+    MakeClip(4, 0.6f, 1, 16, 16),  // BulletImpact
+};
+
+// fresh playback of a clip from its first frame
+constexpr AnimationState StartClip(ClipId clip)
+{
+    return {static_cast<uint8_t>(clip), false, 0.0f};
+}
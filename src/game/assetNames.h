@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/resourceHandle.h"
+
+// names of the built-in sheets, as loaded from BuiltinSheets and hashed at compile
+// time so resolving them never builds or hashes a string at runtime
+namespace AssetName
+{
+inline constexpr NameHash Player = HashName("player");
+inline constexpr NameHash Enemy = HashName("enemy");
+inline constexpr NameHash Bullet = HashName("bullet");
+inline constexpr NameHash Ground = HashName("ground");
+inline constexpr NameHash Panel = HashName("panel");
+inline constexpr NameHash Grass = HashName("grass");
+inline constexpr NameHash Brick = HashName("brick");
+inline constexpr NameHash Background1 = HashName("background_1");
+inline constexpr NameHash Background2 = HashName("background_2");
+}  // namespace AssetName
+
+// every sheet the game loads at startup, files relative to the executable
+inline constexpr struct
+{
+    const char* name;
+    const char* file;
+} BuiltinSheets[] = {
+    {"player", "data/player.png"},
+    {"ground", "data/Ground.png"},
+    {"panel", "data/Panel.png"},
+    {"grass", "data/Grass.png"},
+    {"brick", "data/Brick.png"},
+    {"background_1", "data/Background_1.png"},
+    {"background_2", "data/Background_2.png"},
+    {"bullet", "data/bullet-sheet.png"},
+    {"enemy", "data/player.png"},
+};
@@ -1,4 +1,3 @@
-
 #include "game/bullet.h"
 
 #include <SDL3/SDL_render.h>
@@ -6,74 +5,152 @@
 
 #include <glm/fwd.hpp>
 
-#include "game/gameobject.h"
-Bullet::Bullet(SDL_Texture* atlasTexture, glm::vec2 position, float direction)
+static const float yVariance = 30.0f;
+static const float bullet_velocity = 120.0f;
+
+BulletPool::BulletPool(uint32_t capacity)
+    : posX(capacity),
+      posY(capacity),
+      prevX(capacity),
+      prevY(capacity),
+      velX(capacity),
+      velY(capacity),
+      direction(capacity),
+      state(capacity, BulletState::Inactive),
+      animation(capacity),
+      handleToIndex(capacity, InvalidHandle),
+      indexToHandle(capacity, InvalidHandle)
 {
-    this->texture = atlasTexture;
-    this->tag = Tag::bullet;
-    this->dynamic = true;
-    this->collider = {4, 4, 10, 8};
-    this->state = BulletState::Moving;
-    this->position = position + glm::vec2{18.0f, 15.0f};
-    this->direction = direction;
-
-    this->velocity = {bullet_velocity * direction, SDL_rand(yVariance) - yVariance};
-    animations.emplace_back(4, 0.6f, 0, 16, 16);
-    animations.emplace_back(4, 0.6f, 1, 16, 16);
+    freeHandles.reserve(capacity);
+    for (uint32_t h = capacity; h > 0; h--)
+        freeHandles.push_back(h - 1);
 }
 
-void Bullet::reset(glm::vec2 pos, float dir)
+uint32_t BulletPool::Spawn(glm::vec2 shooterPos, float dir, uint64_t& rng)
 {
-    this->state = BulletState::Moving;
-    this->position = pos + glm::vec2{18.0f, 15.0f};
-    this->direction = dir;
-    this->velocity = {bullet_velocity * dir, SDL_rand(yVariance) - yVariance};
+    if (freeHandles.empty())
+        return InvalidHandle;
+
+    uint32_t handle = freeHandles.back();
+    freeHandles.pop_back();
+    uint32_t i = activeCount++;
+    handleToIndex[handle] = i;
+    indexToHandle[i] = handle;
 
-    if (!animations.empty())
+    state[i] = BulletState::Moving;
+    posX[i] = prevX[i] = shooterPos.x + 18.0f;
+    posY[i] = prevY[i] = shooterPos.y + 15.0f;
+    direction[i] = dir;
+    velX[i] = bullet_velocity * dir;
+    velY[i] = SDL_rand_r(&rng, yVariance) - yVariance;
+    animation[i] = StartClip(ClipId::BulletFlying);
+    return handle;
+}
+
+void BulletPool::Despawn(uint32_t i)
+{
+    uint32_t last = --activeCount;
+    uint32_t handle = indexToHandle[i];
+    if (i != last)
     {
-        currentAnim = 0;
-        animations[currentAnim].reset();
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        prevX[i] = prevX[last];
+        prevY[i] = prevY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        direction[i] = direction[last];
+        state[i] = state[last];
+        animation[i] = animation[last];
+        indexToHandle[i] = indexToHandle[last];
+        handleToIndex[indexToHandle[i]] = i;
     }
+    state[last] = BulletState::Inactive;
+    indexToHandle[last] = InvalidHandle;
+    handleToIndex[handle] = InvalidHandle;
+    freeHandles.push_back(handle);
 }
-void Bullet::update(float deltaTime, const bool* keys)
+
+uint32_t BulletPool::IndexOf(uint32_t handle) const
 {
-    (void)keys;
+    return handle < handleToIndex.size() ? handleToIndex[handle] : InvalidHandle;
+}
 
-    float min_x_boudary = -100.0f;
-    float max_x_boundary = (50 * 32) + 100.0f;
-    if (state == BulletState::Moving)
+void BulletPool::SnapshotPositions()
+{
+    const uint32_t n = activeCount;
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    float* __restrict ox = prevX.data();
+    float* __restrict oy = prevY.data();
+    for (uint32_t i = 0; i < n; i++)
     {
-        if ((this->position.x < min_x_boudary || this->position.x > max_x_boundary))
-        {
-            this->state = BulletState::Inactive;
-        }
-        GameObject::update(deltaTime, keys);
+        ox[i] = px[i];
+        oy[i] = py[i];
     }
-    else if (state == BulletState::Colliding)
+}
+
+void BulletPool::Retire(float minX, float maxX)
+{
+    const uint32_t n = activeCount;
+
+    // bullets that hit something last tick stop and play the impact in place
+    for (uint32_t i = 0; i < n; i++)
     {
-        currentAnim = 1;
-        this->velocity *= 0;
-        if (animations[currentAnim].isDone())
+        if (state[i] == BulletState::Colliding &&
+            animation[i].clip != static_cast<uint8_t>(ClipId::BulletImpact))
         {
-            this->state = BulletState::Inactive;
+            animation[i] = StartClip(ClipId::BulletImpact);
+            velX[i] = 0;
+            velY[i] = 0;
         }
     }
-    if (!animations.empty())
+
+    // retire bullets that left the level or finished their impact animation;
+    // walking backwards keeps the swapped-in bullets already visited
+    for (uint32_t i = n; i > 0; i--)
     {
-        animations[currentAnim].step(deltaTime);
+        uint32_t b = i - 1;
+        bool outOfBounds =
+            state[b] == BulletState::Moving && (posX[b] < minX || posX[b] > maxX);
+        bool impactDone = state[b] == BulletState::Colliding && animation[b].looped;
+        if (outOfBounds || impactDone)
+            Despawn(b);
     }
 }
 
-void Bullet::Render(SDL_Renderer* renderer, glm::vec2 offset)
+void BulletPool::Integrate(float deltaTime)
 {
-    if (animations.empty())
+    // colliding bullets have zero velocity, so every live bullet integrates
+    const uint32_t live = activeCount;
+    float* __restrict px = posX.data();
+    float* __restrict py = posY.data();
+    const float* __restrict vx = velX.data();
+    const float* __restrict vy = velY.data();
+    for (uint32_t i = 0; i < live; i++)
     {
-        return;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
     }
 
-    SDL_FRect src = animations[currentAnim].GetCurrentFrameSrc();
+    AdvanceAnimations(AnimationClips, animation.data(), live, deltaTime);
+}
 
-    SDL_FRect dst = {position.x + offset.x, position.y + offset.y, src.w, src.h};
-    SDL_FlipMode flip = (direction == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderTextureRotated(renderer, texture, &src, &dst, 0, nullptr, flip);
+void BulletPool::Render(SpriteBatch& batch, const SDL_FRect& view, glm::vec2 offset,
+                        float alpha, CullStats& cull) const
+{
+    for (uint32_t i = 0; i < activeCount; i++)
+    {
+        SDL_FRect src = GetFrameSrc(AnimationClips, animation[i], sheet);
+        glm::vec2 pos = GetRenderPosition(i, alpha);
+        if (!Camera::IsVisible(view, {pos.x, pos.y, src.w, src.h}))
+        {
+            cull.culled++;
+            continue;
+        }
+        cull.visible++;
+        SDL_FRect dst = {pos.x + offset.x, pos.y + offset.y, src.w, src.h};
+        SDL_FlipMode flip = (direction[i] == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        batch.Draw(sheet.texture, &src, dst, flip);
+    }
 }
@@ -1,32 +1,81 @@
 #pragma once
 
+#include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_render.h>
 
+#include <cstdint>
+#include <glm/glm.hpp>
 #include <vector>
 
-#include "core/animation.h"
-#include "game/gameobject.h"
-enum class BulletState
+#include "animationClips.h"
+#include "core/camera.h"
+#include "core/spriteBatch.h"
+
+enum class BulletState : uint8_t
 {
     Moving,
     Colliding,
     Inactive,
 };
-class Bullet : public GameObject
-{
-   private:
-    BulletState state;
-    std::vector<Animation> animations;
-    int currentAnim = 0;
-    float direction = 0;
-    float yVariance = 30.0f;
-    float bullet_velocity = 120.0f;
 
+// Fixed-capacity projectile pool. Live bullets are packed into [0, ActiveCount())
+// of plain float columns so integration and the bounds test are straight loops;
+// a despawn swaps the last live bullet into the hole. Handles stay valid across
+// those moves through a free list of slot ids. Nothing here allocates after
+// construction.
+class BulletPool
+{
    public:
-    Bullet(SDL_Texture* atlasTexture, glm::vec2 position, float direction);
-    void update(float deltaTime, const bool* keys) override;
-    void Render(SDL_Renderer* renderer, glm::vec2 offset) override;
-    BulletState GetState() { return state; }
-    void SetState(BulletState c_state) { state = c_state; }
-    void reset(glm::vec2 pos, float dir);
+    static const uint32_t InvalidHandle = 0xFFFFFFFFu;
+    static constexpr SDL_FRect Collider = {4, 4, 10, 8};
+    // size of the pool a level fires into
+    static const uint32_t DefaultCapacity = 4096;
+
+    // dense columns, index i < ActiveCount() is one live bullet
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<float> velX, velY;
+    std::vector<float> direction;
+    std::vector<BulletState> state;
+    // BulletFlying or BulletImpact playback
+    std::vector<AnimationState> animation;
+
+    explicit BulletPool(uint32_t capacity = DefaultCapacity);
+
+    void SetSheet(const AtlasRegion& bulletSheet) { sheet = bulletSheet; }
+    // returns InvalidHandle when the pool is full, the shot is dropped. The spread is
+    // drawn from rng, the caller's SDL_rand_r state.
+    uint32_t Spawn(glm::vec2 shooterPos, float dir, uint64_t& rng);
+    void Despawn(uint32_t i);
+    // dense index of a handle, or InvalidHandle once the bullet is gone
+    uint32_t IndexOf(uint32_t handle) const;
+
+    uint32_t ActiveCount() const { return activeCount; }
+    uint32_t Capacity() const { return static_cast<uint32_t>(posX.size()); }
+    SDL_FRect GetWorldCollider(uint32_t i) const
+    {
+        return {posX[i] + Collider.x, posY[i] + Collider.y, Collider.w, Collider.h};
+    }
+    glm::vec2 GetRenderPosition(uint32_t i, float alpha) const
+    {
+        return {prevX[i] + (posX[i] - prevX[i]) * alpha, prevY[i] + (posY[i] - prevY[i]) * alpha};
+    }
+    void SetState(uint32_t i, BulletState newState) { state[i] = newState; }
+
+    void SnapshotPositions();
+    // starts impacts, retires bullets outside [minX, maxX] and finished impacts
+    void Retire(float minX, float maxX);
+    // moves and animates the bullets that are left, call after Retire
+    void Integrate(float deltaTime);
+    // only bullets overlapping view (world space) are queued
+    void Render(SpriteBatch& batch, const SDL_FRect& view, glm::vec2 offset, float alpha,
+                CullStats& cull) const;
+
+   private:
+    AtlasRegion sheet;
+    uint32_t activeCount = 0;
+    // slot bookkeeping: handle -> dense index and back, free handles form a stack
+    std::vector<uint32_t> handleToIndex;
+    std::vector<uint32_t> indexToHandle;
+    std::vector<uint32_t> freeHandles;
 };
@@ -0,0 +1,259 @@
+#include "chunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/profiler.h"
+
+ChunkStreamer::~ChunkStreamer()
+{
+    WaitForLoads();
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        stopLoader = true;
+    }
+    loadQueued.notify_one();
+    if (loader.joinable())
+        loader.join();
+}
+
+void ChunkStreamer::Attach(const TileGrid* tileGrid, const LevelFile* levelFile)
+{
+    WaitForLoads();
+    grid = tileGrid;
+    file = levelFile;
+    chunks.clear();
+    chunks.resize(static_cast<size_t>(grid->GetChunkCols()) * grid->GetChunkRows());
+    // every chunk resident at once, with two transitions each, is the most an update sees
+    resident.clear();
+    resident.reserve(chunks.size());
+    events.clear();
+    events.reserve(chunks.size() * 2);
+    activeCount = 0;
+    residentCount = 0;
+    {
+        // nothing is in flight after WaitForLoads, the loader sits on an empty ring
+        std::lock_guard<std::mutex> lock(loadMutex);
+        requests.Reset(chunks.size());
+        completions.Reset(chunks.size());
+    }
+    if (!loader.joinable())
+        loader = std::thread([this]() { LoaderLoop(); });
+
+    // counting sort of the spawn table by chunk, a chunk then finds its spawns directly
+    std::span<const LevelSpawn> spawns = file->GetSpawns();
+    const int chunkCols = grid->GetChunkCols();
+    auto chunkOf = [&](const LevelSpawn& spawn)
+    {
+        SDL_Point at = ChunkAt({spawn.x, spawn.y});
+        return static_cast<size_t>(at.y) * chunkCols + at.x;
+    };
+    spawnStart.assign(chunks.size() + 1, 0);
+    for (const LevelSpawn& spawn : spawns)
+        spawnStart[chunkOf(spawn) + 1]++;
+    for (size_t i = 1; i < spawnStart.size(); i++)
+        spawnStart[i] += spawnStart[i - 1];
+    std::vector<uint32_t> next(spawnStart.begin(), spawnStart.end() - 1);
+    spawnOrder.resize(spawns.size());
+    for (uint32_t i = 0; i < spawns.size(); i++)
+        spawnOrder[next[chunkOf(spawns[i])]++] = i;
+}
+
+void ChunkStreamer::WaitForLoads()
+{
+    for (uint32_t index : resident)
+    {
+        if (chunks[index].state == ChunkState::Loading)
+            WaitForLoad(index);
+    }
+}
+
+void ChunkStreamer::LoaderLoop()
+{
+    PROFILE_THREAD("Chunk loader");
+    std::unique_lock<std::mutex> lock(loadMutex);
+    for (;;)
+    {
+        loadQueued.wait(lock, [this]() { return stopLoader || requests.count > 0; });
+        if (stopLoader)
+            return;
+        const uint32_t index = requests.Pop();
+        const int chunkCols = grid->GetChunkCols();
+        lock.unlock();
+        const uint32_t tiles = LoadChunk(index % chunkCols, index / chunkCols);
+        lock.lock();
+        completions.Push({index, tiles});
+        loadFinished.notify_one();
+    }
+}
+
+void ChunkStreamer::DrainCompletions()
+{
+    while (completions.count > 0)
+    {
+        LoadResult result = completions.Pop();
+        chunks[result.chunk].tiles = result.tiles;
+        chunks[result.chunk].loadDone = true;
+    }
+}
+
+void ChunkStreamer::WaitForLoad(uint32_t index)
+{
+    std::unique_lock<std::mutex> lock(loadMutex);
+    DrainCompletions();
+    while (!chunks[index].loadDone)
+    {
+        loadFinished.wait(lock);
+        DrainCompletions();
+    }
+}
+
+SDL_Point ChunkStreamer::ChunkAt(glm::vec2 position) const
+{
+    glm::vec2 origin = grid->GetOrigin();
+    float chunkSize = grid->GetTileSize() * TileGrid::CHUNK_TILES;
+    int cx = static_cast<int>(std::floor((position.x - origin.x) / chunkSize));
+    int cy = static_cast<int>(std::floor((position.y - origin.y) / chunkSize));
+    return {std::clamp(cx, 0, grid->GetChunkCols() - 1),
+            std::clamp(cy, 0, grid->GetChunkRows() - 1)};
+}
+
+uint32_t ChunkStreamer::GetMaxResident(float viewWidth, float viewHeight) const
+{
+    // a view straddles one chunk more than it spans, the unload ring surrounds that
+    const float chunkSize = grid->GetTileSize() * TileGrid::CHUNK_TILES;
+    auto across = [&](float size, int chunkCount)
+    {
+        int span = static_cast<int>(size / chunkSize) + 2 + 2 * UNLOAD_RADIUS;
+        return static_cast<uint32_t>(std::min(span, chunkCount));
+    };
+    return across(viewWidth, grid->GetChunkCols()) * across(viewHeight, grid->GetChunkRows());
+}
+
+uint32_t ChunkStreamer::LoadChunk(int cx, int cy) const
+{
+    PROFILE_ZONE("ChunkStreamer::LoadChunk");
+    // reading the rows faults their pages in here rather than on the first tick that
+    // collides with them; nothing calls TileGrid::SetTile while chunks stream
+    CellRange cells = grid->GetChunkCells(cx, cy);
+    const int cols = grid->GetCols();
+    uint32_t tiles = 0;
+    for (uint32_t layer = 0; layer < LEVEL_LAYER_COUNT; layer++)
+    {
+        const uint16_t* cellIds = file->GetLayer(static_cast<LevelLayer>(layer));
+        for (int r = cells.r0; r <= cells.r1; r++)
+        {
+            for (int c = cells.c0; c <= cells.c1; c++)
+                tiles += cellIds[r * cols + c] != 0;
+        }
+    }
+    return tiles;
+}
+
+void ChunkStreamer::FinishLoad(int cx, int cy, Chunk& chunk, int distance)
+{
+    WaitForLoad(static_cast<uint32_t>(cy * grid->GetChunkCols() + cx));
+    chunk.loadDone = false;
+    if (distance > UNLOAD_RADIUS)
+    {
+        // the camera left before the load came back
+        chunk.tiles = 0;
+        chunk.state = ChunkState::Unloaded;
+        return;
+    }
+    chunk.state = ChunkState::Loaded;
+    events.push_back({cx, cy, ChunkState::Loading, ChunkState::Loaded});
+}
+
+const std::vector<ChunkEvent>& ChunkStreamer::Update(const SDL_FRect& view)
+{
+    PROFILE_ZONE("ChunkStreamer::Update");
+    events.clear();
+    if (chunks.empty())
+        return events;
+
+    const int chunkCols = grid->GetChunkCols();
+    const int chunkRows = grid->GetChunkRows();
+    SDL_Point view0 = ChunkAt({view.x, view.y});
+    SDL_Point view1 = ChunkAt({view.x + view.w, view.y + view.h});
+    auto distance = [&](int cx, int cy)
+    {
+        int dx = std::max({view0.x - cx, cx - view1.x, 0});
+        int dy = std::max({view0.y - cy, cy - view1.y, 0});
+        return std::max(dx, dy);
+    };
+
+    // queue every missing chunk of the load ring first, so the loader works while we
+    // wait on the nearest
+    const size_t residentBefore = resident.size();
+    std::unique_lock<std::mutex> lock(loadMutex);
+    for (int cy = std::max(view0.y - LOAD_RADIUS, 0);
+         cy <= std::min(view1.y + LOAD_RADIUS, chunkRows - 1); cy++)
+    {
+        for (int cx = std::max(view0.x - LOAD_RADIUS, 0);
+             cx <= std::min(view1.x + LOAD_RADIUS, chunkCols - 1); cx++)
+        {
+            Chunk& chunk = chunks[cy * chunkCols + cx];
+            if (chunk.state != ChunkState::Unloaded)
+                continue;
+            chunk.state = ChunkState::Loading;
+            chunk.queuedNow = true;
+            requests.Push(static_cast<uint32_t>(cy * chunkCols + cx));
+            resident.push_back(static_cast<uint32_t>(cy * chunkCols + cx));
+        }
+    }
+    lock.unlock();
+    if (resident.size() != residentBefore)
+        loadQueued.notify_one();
+    // row-major, so the events come in the same order wherever the chunks were queued
+    if (resident.size() != residentBefore)
+        std::sort(resident.begin(), resident.end());
+
+    // everything past the load ring is resident already, nothing else can change state
+    activeCount = 0;
+    residentCount = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < resident.size(); i++)
+    {
+        const uint32_t index = resident[i];
+        const int cx = static_cast<int>(index) % chunkCols;
+        const int cy = static_cast<int>(index) / chunkCols;
+        Chunk& chunk = chunks[index];
+        const int d = distance(cx, cy);
+        if (chunk.state == ChunkState::Loading && (d <= ACTIVE_RADIUS || !chunk.queuedNow))
+            FinishLoad(cx, cy, chunk, d);
+        chunk.queuedNow = false;
+
+        if (chunk.state == ChunkState::Loaded && d <= ACTIVE_RADIUS)
+        {
+            chunk.state = ChunkState::Active;
+            events.push_back({cx, cy, ChunkState::Loaded, ChunkState::Active});
+        }
+        else if (chunk.state == ChunkState::Active && d > ACTIVE_RADIUS)
+        {
+            chunk.state = ChunkState::Loaded;
+            events.push_back({cx, cy, ChunkState::Active, ChunkState::Loaded});
+        }
+        if (chunk.state == ChunkState::Loaded && d > UNLOAD_RADIUS)
+        {
+            chunk.tiles = 0;
+            chunk.state = ChunkState::Unloaded;
+            events.push_back({cx, cy, ChunkState::Loaded, ChunkState::Unloaded});
+        }
+        if (chunk.state == ChunkState::Unloaded)
+            continue;
+
+        resident[kept++] = index;
+        activeCount += chunk.state == ChunkState::Active;
+        residentCount +=
+            chunk.state == ChunkState::Loaded || chunk.state == ChunkState::Active;
+    }
+    resident.resize(kept);
+
+    SDL_FRect first = grid->GetChunkRect(std::max(view0.x - ACTIVE_RADIUS, 0),
+                                         std::max(view0.y - ACTIVE_RADIUS, 0));
+    SDL_FRect last = grid->GetChunkRect(std::min(view1.x + ACTIVE_RADIUS, chunkCols - 1),
+                                        std::min(view1.y + ACTIVE_RADIUS, chunkRows - 1));
+    activeBounds = {first.x, first.y, last.x + last.w - first.x, last.y + last.h - first.y};
+    return events;
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "levelFile.h"
+#include "tileGrid.h"
+
+enum class ChunkState : uint8_t
+{
+    Unloaded,
+    Loading,  // queued on the loader thread
+    Loaded,   // resident, its entities exist but sleep
+    Active,   // simulated and drawn
+};
+
+// a chunk that changed state in the last Update
+struct ChunkEvent
+{
+    int cx, cy;
+    ChunkState previous;
+    ChunkState state;
+};
+
+// Splits a level into TileGrid::CHUNK_TILES square chunks and moves them through
+// ChunkState by their distance (in chunks) from the chunks under the camera view.
+// Loading runs on a background thread one ring ahead of activation: it faults the
+// chunk's tile rows in from the mapped level file, so a chunk that turns active is
+// normally ready already. The unload ring is wider than the load ring so a camera
+// moving back and forth over a border does not thrash. An update only visits the load
+// ring and the chunks already resident, and the spawns are bucketed by chunk once in
+// Attach, so neither the per-tick nor the per-load cost grows with the level size.
+// Requests and results pass through rings sized to the chunk count in Attach, which
+// also reserves every list Update fills, so streaming never touches the heap.
+class ChunkStreamer
+{
+   public:
+    static const int ACTIVE_RADIUS = 1;
+    static const int LOAD_RADIUS = 2;
+    static const int UNLOAD_RADIUS = 3;
+
+   private:
+    struct Chunk
+    {
+        ChunkState state = ChunkState::Unloaded;
+        // non-empty cells over all layers, valid once loadDone
+        uint32_t tiles = 0;
+        bool loadDone = false;
+        // queued by the current Update, collected by the next one
+        bool queuedNow = false;
+    };
+    // what the loader thread hands back
+    struct LoadResult
+    {
+        uint32_t chunk;
+        uint32_t tiles;
+    };
+    // FIFO over a fixed array; a chunk is in flight at most once, so one slot per chunk
+    // never overflows
+    template <typename T>
+    struct Ring
+    {
+        std::vector<T> slots;
+        size_t head = 0;
+        size_t count = 0;
+
+        void Reset(size_t capacity)
+        {
+            slots.assign(capacity, T{});
+            head = 0;
+            count = 0;
+        }
+        void Push(const T& value) { slots[(head + count++) % slots.size()] = value; }
+        T Pop()
+        {
+            T value = slots[head];
+            head = (head + 1) % slots.size();
+            count--;
+            return value;
+        }
+    };
+
+    const TileGrid* grid = nullptr;
+    const LevelFile* file = nullptr;
+    std::vector<Chunk> chunks;
+    // indices of the chunks that are not Unloaded, in row-major order
+    std::vector<uint32_t> resident;
+    // spawn table indices grouped by chunk: chunk i owns
+    // spawnOrder[spawnStart[i]] up to spawnOrder[spawnStart[i + 1]]
+    std::vector<uint32_t> spawnStart;
+    std::vector<uint32_t> spawnOrder;
+    std::vector<ChunkEvent> events;
+
+    // loads are small and must stay in order of need, one thread is plenty.
+    // loadMutex guards the rings and stopLoader
+    std::thread loader;
+    std::mutex loadMutex;
+    std::condition_variable loadQueued;
+    std::condition_variable loadFinished;
+    Ring<uint32_t> requests;
+    Ring<LoadResult> completions;
+    bool stopLoader = false;
+
+    SDL_FRect activeBounds{0, 0, 0, 0};
+    uint32_t activeCount = 0;
+    uint32_t residentCount = 0;
+
+    void LoaderLoop();
+    // runs on the loader thread, only reads the grid layout and the file
+    uint32_t LoadChunk(int cx, int cy) const;
+    // hands finished loads to their chunks, loadMutex held
+    void DrainCompletions();
+    // blocks until the load of chunks[index] came back
+    void WaitForLoad(uint32_t index);
+    void FinishLoad(int cx, int cy, Chunk& chunk, int distance);
+
+   public:
+    ChunkStreamer() = default;
+    ~ChunkStreamer();
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // grid gives the chunk layout, file the spawns and tile layers; both outlive the streamer
+    void Attach(const TileGrid* tileGrid, const LevelFile* levelFile);
+    // moves chunks towards the state their distance from view (world space) asks for.
+    // A load is collected on the Update after the one that queued it, or at once for a
+    // chunk entering the active ring, waiting if it is still running; the transitions
+    // then depend on the views alone and never on the loader's timing, so runs replay.
+    // Returns the transitions of this call, valid until the next one.
+    const std::vector<ChunkEvent>& Update(const SDL_FRect& view);
+    // blocks until no load is in flight, e.g. before the level file goes away
+    void WaitForLoads();
+
+    // chunk holding a world position, positions off the grid clamp to the border chunks
+    SDL_Point ChunkAt(glm::vec2 position) const;
+    ChunkState GetState(SDL_Point chunk) const
+    {
+        return chunks[chunk.y * grid->GetChunkCols() + chunk.x].state;
+    }
+    // spawn table entries inside a chunk, in table order
+    std::span<const uint32_t> GetSpawns(int cx, int cy) const
+    {
+        const size_t i = static_cast<size_t>(cy) * grid->GetChunkCols() + cx;
+        return {spawnOrder.data() + spawnStart[i], spawnStart[i + 1] - spawnStart[i]};
+    }
+    // non-empty cells of a loaded chunk over all layers, 0 means there is nothing to bake
+    uint32_t GetTileCount(int cx, int cy) const
+    {
+        return chunks[cy * grid->GetChunkCols() + cx].tiles;
+    }
+    // most chunks a view of this size (world units) keeps Loaded or Active at once
+    uint32_t GetMaxResident(float viewWidth, float viewHeight) const;
+    // world rect of the active ring, nothing outside it is simulated
+    SDL_FRect GetActiveBounds() const { return activeBounds; }
+    uint32_t GetActiveCount() const { return activeCount; }
+    // loaded and active chunks
+    uint32_t GetResidentCount() const { return residentCount; }
+};
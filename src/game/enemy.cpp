@@ -2,61 +2,49 @@
 
 #include <SDL3/SDL_render.h>
 
-#include <cmath>
+static const float walkSpeed = 40.0f;
+static const float gravity = 500.0f;
 
-Enemy::Enemy(SDL_Texture* atlasTexture)
+uint32_t SpawnEnemy(EntityStore& store, const AtlasRegion& sheet, glm::vec2 position)
 {
-    this->texture = atlasTexture;
-    this->tag = Tag::enemy;
-    this->dynamic = true;
-    this->collider = {4, 6, 24, 26};
-    this->velocity.x = walkSpeed * direction;
-
-    animations.emplace_back(4, 0.8f, 0, 32, 32);
+    uint32_t i = store.Create(EntityTag::enemy, position, {4, 6, 24, 26}, sheet);
+    store.state[i] = static_cast<uint8_t>(EnemyState::Patrolling);
+    store.direction[i] = -1.0f;
+    store.velocity[i].x = walkSpeed * store.direction[i];
+    store.animation[i] = StartClip(ClipId::EnemyWalk);
+    return i;
 }
 
-void Enemy::update(float deltaTime, const bool* keys)
+void UpdateEnemies(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end)
 {
-    if (state == EnemyState::Dead)
-        return;
-
-    if (!grounded)
-        velocity.y += gravity * deltaTime;
-
-    // Keep moving in the current direction
-    velocity.x = walkSpeed * direction;
-
-    this->grounded = false;
-
-    if (!animations.empty())
+    for (uint32_t i = begin; i < end; i++)
     {
-        animations[currentAnim].step(deltaTime);
-    }
+        if (store.tag[i] != EntityTag::enemy ||
+            store.state[i] == static_cast<uint8_t>(EnemyState::Dead) ||
+            store.Has(i, EntityStore::Asleep))
+            continue;
 
-    GameObject::update(deltaTime, keys);
-}
+        if (!store.Has(i, EntityStore::Grounded))
+            store.velocity[i].y += gravity * deltaTime;
 
-void Enemy::Render(SDL_Renderer* renderer, glm::vec2 offset)
-{
-    if (state == EnemyState::Dead || animations.empty())
-        return;
+        // Keep moving in the current direction
+        store.velocity[i].x = walkSpeed * store.direction[i];
 
-    SDL_FRect src = animations[currentAnim].GetCurrentFrameSrc();
-    SDL_FRect dst = {position.x + offset.x, position.y + offset.y, src.w, src.h};
-
-    SDL_FlipMode flip = (direction == 1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderTextureRotated(renderer, texture, &src, &dst, 0, nullptr, flip);
+        store.Set(i, EntityStore::Grounded, false);
+    }
 }
 
-void Enemy::takeDamage()
+void DamageEnemy(EntityStore& store, uint32_t i)
 {
-    state = EnemyState::Dead;
-    this->collider = {0, 0, 0, 0};
-    this->velocity = {0, 0};
+    store.state[i] = static_cast<uint8_t>(EnemyState::Dead);
+    store.Set(i, EntityStore::Dynamic, false);
+    store.Set(i, EntityStore::Visible, false);
+    store.collider[i] = {0, 0, 0, 0};
+    store.velocity[i] = {0, 0};
 }
 
-void Enemy::reverseDirection()
+void ReverseEnemy(EntityStore& store, uint32_t i)
 {
-    direction *= -1.0f;
-    velocity.x = walkSpeed * direction;
+    store.direction[i] *= -1.0f;
+    store.velocity[i].x = walkSpeed * store.direction[i];
 }
@@ -1,32 +1,19 @@
 #pragma once
-#include <vector>
+#include <SDL3/SDL_render.h>
 
-#include "core/animation.h"
-#include "gameobject.h"
+#include <cstdint>
+#include <glm/glm.hpp>
 
-enum class EnemyState
+#include "entityStore.h"
+
+enum class EnemyState : uint8_t
 {
     Patrolling,
     Dead
 };
 
-class Enemy : public GameObject
-{
-   private:
-    EnemyState state = EnemyState::Patrolling;
-    float walkSpeed = 40.0f;
-    float direction = -1.0f;
-    std::vector<Animation> animations;
-    int currentAnim = 0;
-    float gravity = 500.0f;
-    bool grounded = false;
-
-   public:
-    Enemy(SDL_Texture* atlasTexture);
-    void update(float deltaTime, const bool* keys) override;
-    void Render(SDL_Renderer* renderer, glm::vec2 offset) override;
-    EnemyState getState() { return state; }
-    void setGrounded(bool val) { grounded = val; }
-    void takeDamage();
-    void reverseDirection();
-};
+uint32_t SpawnEnemy(EntityStore& store, const AtlasRegion& sheet, glm::vec2 position);
+// patrol and gravity for the enemies among entities [begin, end)
+void UpdateEnemies(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end);
+void DamageEnemy(EntityStore& store, uint32_t i);
+void ReverseEnemy(EntityStore& store, uint32_t i);
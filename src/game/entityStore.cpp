@@ -0,0 +1,111 @@
+#include "entityStore.h"
+
+#include <SDL3/SDL_render.h>
+
+uint32_t EntityStore::Create(EntityTag entityTag, glm::vec2 pos, SDL_FRect box,
+                             const AtlasRegion& sprite)
+{
+    uint32_t i = Size();
+    position.push_back(pos);
+    prevPosition.push_back(pos);
+    velocity.push_back({0.0f, 0.0f});
+    collider.push_back(box);
+    tag.push_back(entityTag);
+    flags.push_back(Dynamic | Visible);
+    state.push_back(0);
+    direction.push_back(1.0f);
+    animation.emplace_back();
+    sheet.push_back(sprite);
+    spawn.push_back(NoSpawn);
+    return i;
+}
+
+uint32_t EntityStore::Destroy(uint32_t i)
+{
+    uint32_t last = Size() - 1;
+    position[i] = position[last];
+    prevPosition[i] = prevPosition[last];
+    velocity[i] = velocity[last];
+    collider[i] = collider[last];
+    tag[i] = tag[last];
+    flags[i] = flags[last];
+    state[i] = state[last];
+    direction[i] = direction[last];
+    animation[i] = animation[last];
+    sheet[i] = sheet[last];
+    spawn[i] = spawn[last];
+
+    position.pop_back();
+    prevPosition.pop_back();
+    velocity.pop_back();
+    collider.pop_back();
+    tag.pop_back();
+    flags.pop_back();
+    state.pop_back();
+    direction.pop_back();
+    animation.pop_back();
+    sheet.pop_back();
+    spawn.pop_back();
+    return last;
+}
+
+void EntityStore::Reserve(size_t count)
+{
+    position.reserve(count);
+    prevPosition.reserve(count);
+    velocity.reserve(count);
+    collider.reserve(count);
+    tag.reserve(count);
+    flags.reserve(count);
+    state.reserve(count);
+    direction.reserve(count);
+    animation.reserve(count);
+    sheet.reserve(count);
+    spawn.reserve(count);
+}
+
+void SnapshotPositions(EntityStore& store) { store.prevPosition = store.position; }
+
+void IntegrateBodies(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        if (store.Has(i, EntityStore::Dynamic) && !store.Has(i, EntityStore::Asleep))
+            store.position[i] += store.velocity[i] * deltaTime;
+    }
+}
+
+void StepAnimations(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; i++)
+    {
+        if (store.Has(i, EntityStore::Visible) && !store.Has(i, EntityStore::Asleep))
+            StepAnimation(AnimationClips, store.animation[i], deltaTime);
+    }
+}
+
+void RenderEntities(const EntityStore& store, SpriteBatch& batch, const SDL_FRect& view,
+                    glm::vec2 offset, float alpha, CullStats& cull)
+{
+    const uint32_t count = store.Size();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!store.Has(i, EntityStore::Visible) || store.Has(i, EntityStore::Asleep))
+            continue;
+
+        SDL_FRect src = GetFrameSrc(AnimationClips, store.animation[i], store.sheet[i]);
+        glm::vec2 pos = store.GetRenderPosition(i, alpha);
+        if (!Camera::IsVisible(view, {pos.x, pos.y, src.w, src.h}))
+        {
+            cull.culled++;
+            continue;
+        }
+        cull.visible++;
+        SDL_FRect dst = {pos.x + offset.x, pos.y + offset.y, src.w, src.h};
+
+        // the enemy sheet faces left, the player sheet faces right
+        float facing = store.tag[i] == EntityTag::enemy ? 1.0f : -1.0f;
+        SDL_FlipMode flip = (store.direction[i] == facing) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        batch.Draw(store.sheet[i].texture, &src, dst, flip);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "animationClips.h"
+#include "core/camera.h"
+#include "core/spriteBatch.h"
+
+enum class EntityTag : uint8_t
+{
+    player,
+    enemy
+};
+
+// Struct-of-arrays storage for every live entity. Index i across all columns is one
+// entity; Player and Enemy are just the set of columns their systems use. Bullets
+// churn too fast for this layout and live in their own BulletPool.
+class EntityStore
+{
+   public:
+    enum Flag : uint8_t
+    {
+        Dynamic = 1 << 0,   // integrated by IntegrateBodies and collided with the level
+        Grounded = 1 << 1,  // standing on a solid tile this tick
+        Visible = 1 << 2,   // drawn by RenderEntities
+        Asleep = 1 << 3,    // its chunk is loaded but not active, every system skips it
+    };
+    // spawn value of entities that are not from the level's spawn table
+    static const uint32_t NoSpawn = 0xFFFFFFFFu;
+
+    std::vector<glm::vec2> position;
+    // position at the start of the current tick, rendering blends towards position
+    std::vector<glm::vec2> prevPosition;
+    std::vector<glm::vec2> velocity;
+    std::vector<SDL_FRect> collider;
+    std::vector<EntityTag> tag;
+    std::vector<uint8_t> flags;
+    // per-tag state machine value (PlayerState or EnemyState)
+    std::vector<uint8_t> state;
+    std::vector<float> direction;
+    // clip and time into it, the clip definitions are shared AnimationClips
+    std::vector<AnimationState> animation;
+    // atlas region of the sprite sheet the clips index into
+    std::vector<AtlasRegion> sheet;
+    // level spawn table entry the entity came from, lets chunk streaming respawn it
+    std::vector<uint32_t> spawn;
+
+    uint32_t Create(EntityTag entityTag, glm::vec2 pos, SDL_FRect box, const AtlasRegion& sprite);
+    // removes entity i by moving the last entity into its slot, returns the index that
+    // moved (Size() before the call - 1) so callers can fix references to it
+    uint32_t Destroy(uint32_t i);
+    void Reserve(size_t count);
+    uint32_t Size() const { return static_cast<uint32_t>(position.size()); }
+
+    bool Has(uint32_t i, Flag flag) const { return (flags[i] & flag) != 0; }
+    void Set(uint32_t i, Flag flag, bool on)
+    {
+        flags[i] = on ? (flags[i] | flag) : (flags[i] & ~flag);
+    }
+    SDL_FRect GetWorldCollider(uint32_t i) const
+    {
+        return {position[i].x + collider[i].x, position[i].y + collider[i].y, collider[i].w,
+                collider[i].h};
+    }
+    glm::vec2 GetRenderPosition(uint32_t i, float alpha) const
+    {
+        return prevPosition[i] + (position[i] - prevPosition[i]) * alpha;
+    }
+    // switch to a clip from its start, no-op if it is already playing
+    void SetClip(uint32_t i, ClipId clip)
+    {
+        if (animation[i].clip != static_cast<uint8_t>(clip))
+            animation[i] = StartClip(clip);
+    }
+};
+
+// systems shared by every entity kind, each is one linear pass over the columns. The
+// [begin, end) ones only touch their own indices, so ranges can run on different threads.
+void SnapshotPositions(EntityStore& store);
+void IntegrateBodies(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end);
+void StepAnimations(EntityStore& store, float deltaTime, uint32_t begin, uint32_t end);
+// only entities overlapping view (world space) are queued
+void RenderEntities(const EntityStore& store, SpriteBatch& batch, const SDL_FRect& view,
+                    glm::vec2 offset, float alpha, CullStats& cull);
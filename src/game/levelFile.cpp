@@ -0,0 +1,328 @@
+#include "levelFile.h"
+
+#include <SDL3/SDL_log.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+static uint64_t AlignUp(uint64_t value) { return (value + 3) & ~uint64_t(3); }
+
+bool LevelFile::Validate(const std::string& path)
+{
+    if (size < sizeof(LevelHeader))
+    {
+        SDL_Log("Level %s: file too small", path.c_str());
+        return false;
+    }
+    const LevelHeader& header = GetHeader();
+    if (std::memcmp(header.magic, "GLVL", 4) != 0)
+    {
+        SDL_Log("Level %s: not a level file", path.c_str());
+        return false;
+    }
+    if (header.version != LEVEL_FILE_VERSION)
+    {
+        SDL_Log("Level %s: version %u, expected %u", path.c_str(), header.version,
+                LEVEL_FILE_VERSION);
+        return false;
+    }
+
+    uint64_t layerBytes = LevelLayerBytes(header.cols, header.rows);
+    const struct
+    {
+        uint64_t offset;
+        uint64_t bytes;
+    } sections[] = {{header.layersOffset, layerBytes},
+                    {header.spawnsOffset, uint64_t(header.spawnCount) * sizeof(LevelSpawn)},
+                    {header.parallaxOffset,
+                     uint64_t(header.parallaxCount) * sizeof(LevelParallax)}};
+    for (const auto& section : sections)
+    {
+        if (section.offset % 4 != 0 || section.offset + section.bytes > size)
+        {
+            SDL_Log("Level %s: truncated or misaligned section", path.c_str());
+            return false;
+        }
+    }
+    if (header.cols == 0 || header.rows == 0 || !(header.tileSize > 0.0f))
+    {
+        SDL_Log("Level %s: empty grid", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LevelFile::Open(const std::string& path)
+{
+    converted.clear();
+    data = nullptr;
+    size = 0;
+    if (!mapping.Open(path))
+        return false;
+    data = mapping.GetData();
+    size = mapping.GetSize();
+    return Validate(path);
+}
+
+bool LevelFile::OpenText(const std::string& path)
+{
+    mapping.Close();
+    data = nullptr;
+    size = 0;
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return OpenSource(text, path);
+}
+
+bool LevelFile::OpenSource(std::string_view text, const std::string& name)
+{
+    mapping.Close();
+    data = nullptr;
+    size = 0;
+    if (!ConvertTextLevel(text, converted))
+        return false;
+    data = converted.data();
+    size = converted.size();
+    return Validate(name);
+}
+
+uint16_t* LevelFile::GetLayer(LevelLayer layer) const
+{
+    const LevelHeader& header = GetHeader();
+    size_t layerBytes = size_t(header.cols) * header.rows * sizeof(uint16_t);
+    return reinterpret_cast<uint16_t*>(data + header.layersOffset +
+                                       static_cast<size_t>(layer) * layerBytes);
+}
+
+std::span<const LevelSpawn> LevelFile::GetSpawns() const
+{
+    const LevelHeader& header = GetHeader();
+    return {reinterpret_cast<const LevelSpawn*>(data + header.spawnsOffset), header.spawnCount};
+}
+
+std::span<const LevelParallax> LevelFile::GetParallax() const
+{
+    const LevelHeader& header = GetHeader();
+    return {reinterpret_cast<const LevelParallax*>(data + header.parallaxOffset),
+            header.parallaxCount};
+}
+
+static bool ParseFloat(const std::string& token, float& out)
+{
+    char* end = nullptr;
+    out = std::strtof(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0';
+}
+
+static bool ParseUInt(const std::string& token, uint32_t maxValue, uint32_t& out)
+{
+    char* end = nullptr;
+    unsigned long value = std::strtoul(token.c_str(), &end, 10);
+    if (end == token.c_str() || *end != '\0' || token[0] == '-' || value > maxValue)
+        return false;
+    out = static_cast<uint32_t>(value);
+    return true;
+}
+
+bool ConvertTextLevel(std::string_view text, std::vector<uint8_t>& out)
+{
+    struct CellSpawn
+    {
+        SpawnKind kind;
+        uint32_t col, row;
+    };
+
+    uint32_t cols = 0, rows = 0;
+    float tileSize = 32.0f, originX = 0.0f, originY = 0.0f;
+    std::vector<LevelParallax> parallax;
+    std::vector<CellSpawn> spawns;
+    std::vector<uint16_t> layers[LEVEL_LAYER_COUNT];
+    std::vector<uint16_t>* currentLayer = nullptr;
+
+    int lineNumber = 0;
+    std::istringstream input{std::string(text)};
+    std::string line;
+    while (std::getline(input, line))
+    {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        for (char& c : line)
+        {
+            if (c == ',' || c == '\r' || c == '\t')
+                c = ' ';
+        }
+        std::istringstream words(line);
+        std::vector<std::string> tokens{std::istream_iterator<std::string>(words),
+                                        std::istream_iterator<std::string>()};
+        if (tokens.empty())
+            continue;
+
+        bool ok = true;
+        const std::string& key = tokens[0];
+        if (currentLayer && currentLayer->size() < size_t(cols) * rows)
+        {
+            // one row of tile ids
+            ok = tokens.size() == cols;
+            for (size_t i = 0; ok && i < tokens.size(); i++)
+            {
+                uint32_t id = 0;
+                ok = ParseUInt(tokens[i], 0xFFFF, id);
+                currentLayer->push_back(static_cast<uint16_t>(id));
+            }
+        }
+        else if (key == "size" && tokens.size() == 3)
+        {
+            ok = ParseUInt(tokens[1], 1u << 20, cols) && ParseUInt(tokens[2], 1u << 20, rows) &&
+                 cols > 0 && rows > 0;
+        }
+        else if (key == "tile" && tokens.size() == 2)
+        {
+            ok = ParseFloat(tokens[1], tileSize) && tileSize > 0.0f;
+        }
+        else if (key == "origin" && tokens.size() == 3)
+        {
+            ok = ParseFloat(tokens[1], originX) && ParseFloat(tokens[2], originY);
+        }
+        else if (key == "parallax" && tokens.size() >= 4 && tokens.size() <= 6)
+        {
+            LevelParallax layer = {HashName(tokens[1]), 0.0f, 0.0f, 0.0f, LevelParallax::RepeatX};
+            ok = ParseFloat(tokens[2], layer.scrollSpeed) && ParseFloat(tokens[3], layer.y);
+            if (ok && tokens.size() >= 5)
+                ok = ParseFloat(tokens[4], layer.scrollSpeedY);
+            if (ok && tokens.size() == 6)
+            {
+                const std::string& repeat = tokens[5];
+                layer.repeat = repeat == "x"    ? LevelParallax::RepeatX
+                               : repeat == "y"  ? LevelParallax::RepeatY
+                               : repeat == "xy" ? LevelParallax::RepeatX | LevelParallax::RepeatY
+                                                : LevelParallax::RepeatNone;
+                ok = layer.repeat != LevelParallax::RepeatNone || repeat == "none";
+            }
+            parallax.push_back(layer);
+        }
+        else if (key == "spawn" && tokens.size() == 4 &&
+                 (tokens[1] == "player" || tokens[1] == "enemy"))
+        {
+            CellSpawn spawn = {tokens[1] == "player" ? SpawnKind::Player : SpawnKind::Enemy, 0, 0};
+            ok = ParseUInt(tokens[2], 1u << 20, spawn.col) &&
+                 ParseUInt(tokens[3], 1u << 20, spawn.row);
+            spawns.push_back(spawn);
+        }
+        else if (key == "layer" && tokens.size() == 2 && cols > 0)
+        {
+            const char* names[LEVEL_LAYER_COUNT] = {"background", "level", "foreground"};
+            currentLayer = nullptr;
+            for (uint32_t i = 0; i < LEVEL_LAYER_COUNT; i++)
+            {
+                if (tokens[1] == names[i] && layers[i].empty())
+                    currentLayer = &layers[i];
+            }
+            ok = currentLayer != nullptr;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (!ok)
+        {
+            SDL_Log("Level text line %d: cannot parse \"%s\"", lineNumber, line.c_str());
+            return false;
+        }
+    }
+
+    if (cols == 0)
+    {
+        SDL_Log("Level text: missing size");
+        return false;
+    }
+    // laid out in 64 bits, the header only takes it once it is known to fit
+    const uint64_t layersOffset = AlignUp(sizeof(LevelHeader));
+    const uint64_t spawnsOffset = AlignUp(layersOffset + LevelLayerBytes(cols, rows));
+    const uint64_t parallaxOffset = AlignUp(spawnsOffset + spawns.size() * sizeof(LevelSpawn));
+    const uint64_t imageBytes = parallaxOffset + parallax.size() * sizeof(LevelParallax);
+    if (imageBytes > LEVEL_MAX_IMAGE_BYTES)
+    {
+        SDL_Log("Level text: %ux%u cells need %llu bytes, the format holds at most %llu", cols,
+                rows, static_cast<unsigned long long>(imageBytes),
+                static_cast<unsigned long long>(LEVEL_MAX_IMAGE_BYTES));
+        return false;
+    }
+
+    const size_t cells = size_t(cols) * rows;
+    for (std::vector<uint16_t>& layer : layers)
+    {
+        if (layer.empty())
+            layer.assign(cells, 0);
+        if (layer.size() != cells)
+        {
+            SDL_Log("Level text: a layer has %zu of %zu tiles", layer.size(), cells);
+            return false;
+        }
+    }
+
+    LevelHeader header = {};
+    std::memcpy(header.magic, "GLVL", 4);
+    header.version = LEVEL_FILE_VERSION;
+    header.cols = cols;
+    header.rows = rows;
+    header.tileSize = tileSize;
+    header.originX = originX;
+    header.originY = originY;
+    header.spawnCount = static_cast<uint32_t>(spawns.size());
+    header.parallaxCount = static_cast<uint32_t>(parallax.size());
+    header.layersOffset = static_cast<uint32_t>(layersOffset);
+    header.spawnsOffset = static_cast<uint32_t>(spawnsOffset);
+    header.parallaxOffset = static_cast<uint32_t>(parallaxOffset);
+
+    out.assign(imageBytes, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    for (uint32_t i = 0; i < LEVEL_LAYER_COUNT; i++)
+    {
+        std::memcpy(out.data() + header.layersOffset + i * cells * sizeof(uint16_t),
+                    layers[i].data(), cells * sizeof(uint16_t));
+    }
+    for (size_t i = 0; i < spawns.size(); i++)
+    {
+        LevelSpawn spawn = {spawns[i].kind, 0, originX + spawns[i].col * tileSize,
+                            originY + spawns[i].row * tileSize};
+        std::memcpy(out.data() + header.spawnsOffset + i * sizeof(LevelSpawn), &spawn,
+                    sizeof(spawn));
+    }
+    if (!parallax.empty())
+    {
+        std::memcpy(out.data() + header.parallaxOffset, parallax.data(),
+                    parallax.size() * sizeof(LevelParallax));
+    }
+    return true;
+}
+
+bool ConvertLevelFile(const std::string& input, const std::string& output)
+{
+    std::ifstream source(input, std::ios::binary);
+    if (!source)
+    {
+        SDL_Log("Cannot read %s", input.c_str());
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+
+    std::vector<uint8_t> image;
+    if (!ConvertTextLevel(text, image))
+        return false;
+
+    std::ofstream target(output, std::ios::binary | std::ios::trunc);
+    target.write(reinterpret_cast<const char*>(image.data()),
+                 static_cast<std::streamsize>(image.size()));
+    if (!target)
+    {
+        SDL_Log("Cannot write %s", output.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/mappedFile.h"
+#include "core/resourceHandle.h"
+
+// On-disk level layout, version 2 (version 1 had no vertical parallax). Little-endian,
+// the structs below are written as they are in memory and every section starts 4-byte
+// aligned, so a mapped file is used in place:
+//   LevelHeader
+//   LEVEL_LAYER_COUNT layers of cols * rows uint16 tile ids, row-major
+//   spawnCount LevelSpawn
+//   parallaxCount LevelParallax
+
+enum class LevelLayer : uint32_t
+{
+    Background,
+    Level,
+    Foreground,
+};
+inline constexpr uint32_t LEVEL_LAYER_COUNT = 3;
+
+enum class SpawnKind : uint16_t
+{
+    Player = 1,
+    Enemy = 2,
+};
+
+struct LevelHeader
+{
+    char magic[4];  // "GLVL"
+    uint32_t version;
+    uint32_t cols;
+    uint32_t rows;
+    float tileSize;
+    float originX;  // world position of the top-left cell
+    float originY;
+    uint32_t spawnCount;
+    uint32_t parallaxCount;
+    // byte offsets of the sections from the start of the file
+    uint32_t layersOffset;
+    uint32_t spawnsOffset;
+    uint32_t parallaxOffset;
+};
+
+struct LevelSpawn
+{
+    SpawnKind kind;
+    uint16_t reserved;
+    float x, y;  // world position
+};
+
+struct LevelParallax
+{
+    // axes the layer repeats along to fill the view
+    enum Repeat : uint32_t
+    {
+        RepeatNone = 0,
+        RepeatX = 1 << 0,
+        RepeatY = 1 << 1,
+    };
+
+    NameHash sprite;     // HashName of the sheet
+    float scrollSpeed;   // horizontal, 0 static, 1 moves with the level
+    float scrollSpeedY;  // vertical, same scale
+    float y;             // screen y of the layer with the camera at the top
+    uint32_t repeat;     // Repeat bits
+};
+
+static_assert(sizeof(LevelHeader) == 48 && sizeof(LevelSpawn) == 12 &&
+              sizeof(LevelParallax) == 20);
+
+inline constexpr uint32_t LEVEL_FILE_VERSION = 2;
+// section offsets are 32-bit, an image past this many bytes cannot be addressed
+inline constexpr uint64_t LEVEL_MAX_IMAGE_BYTES = UINT32_MAX;
+
+// bytes of the tile layers of a cols x rows level, the bulk of an image
+inline constexpr uint64_t LevelLayerBytes(uint64_t cols, uint64_t rows)
+{
+    return cols * rows * sizeof(uint16_t) * LEVEL_LAYER_COUNT;
+}
+
+// A validated level image, either mapped from a binary file or converted from text
+// into an owned buffer. Tile layers are writable views into it, nothing is copied.
+class LevelFile
+{
+    MappedFile mapping;
+    std::vector<uint8_t> converted;
+    uint8_t* data = nullptr;
+    size_t size = 0;
+
+    bool Validate(const std::string& path);
+
+   public:
+    // maps a binary level, false (with an SDL_Log) if missing or malformed
+    bool Open(const std::string& path);
+    // converts a text level in memory, for maps nobody has converted yet
+    bool OpenText(const std::string& path);
+    // converts level text held in memory, name only labels the log messages
+    bool OpenSource(std::string_view text, const std::string& name);
+
+    const LevelHeader& GetHeader() const { return *reinterpret_cast<const LevelHeader*>(data); }
+    uint16_t* GetLayer(LevelLayer layer) const;
+    std::span<const LevelSpawn> GetSpawns() const;
+    std::span<const LevelParallax> GetParallax() const;
+};
+
+// Text level source to a binary image. Line based, '#' starts a comment:
+//   size COLS ROWS | tile SIZE | origin X Y | spawn player|enemy COL ROW
+//   parallax SHEET SPEED Y [SPEED_Y [x|y|xy|none]], repeating along x by default
+//   layer background|level|foreground, followed by ROWS lines of COLS comma separated ids
+bool ConvertTextLevel(std::string_view text, std::vector<uint8_t>& out);
+// reads input, writes the binary image to output
+bool ConvertLevelFile(const std::string& input, const std::string& output);
@@ -1,92 +1,116 @@
 #include "player.h"
 
 #include <SDL3/SDL_render.h>
-#include <SDL3/SDL_scancode.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <glm/fwd.hpp>
 
-Player::Player(SDL_Texture* atlasTexture)
+#include "bullet.h"
+
+// constants for the player
+static const float maxSpeedX = 80.0f;
+static const glm::vec2 acceleration{250.0f, 0.0f};
+static const float jump_power = -300.0f;
+static const float gravity = 500.0f;
+
+uint32_t SpawnPlayer(EntityStore& store, PlayerController& player, const AtlasRegion& sheet,
+                     glm::vec2 position)
 {
-    // loading texture pointer
-    // configure the player
-    this->texture = atlasTexture;
-    this->tag = Tag::player;
-    this->dynamic = true;
-    this->collider = {8, 6, 14, 26};
-    weaponTimer.step(20.0f);
-    animations.emplace_back(4, 0.6f, 2, 32, 32);  // idel
-    animations.emplace_back(8, 1.2f, 3, 32, 32);  // run
-    animations.emplace_back(8, 1.2f, 5, 32, 32);  // jump
-    animations.emplace_back(2, 0.3f, 0, 32, 32);  // slide
+    uint32_t i = store.Create(EntityTag::player, position, {8, 6, 14, 26}, sheet);
+    store.Set(i, EntityStore::Grounded, true);
+    store.state[i] = static_cast<uint8_t>(PlayerState::Idle);
+    store.animation[i] = StartClip(ClipId::PlayerIdle);
+
+    player.entity = i;
+    player.state = PlayerState::Idle;
+    player.weaponTimer.step(20.0f);
+    return i;
 }
 
-void Player::update(float deltaTime, const bool* keys)
+void UpdatePlayer(EntityStore& store, PlayerController& player, float deltaTime,
+                  const InputState& input)
 {
+    const uint32_t i = player.entity;
+    glm::vec2& velocity = store.velocity[i];
+    float& direction = store.direction[i];
+
     float dirInput = 0;
-    if (keys[SDL_SCANCODE_A])
+    if (input.IsDown(InputState::Left))
         dirInput = -1;
-    if (keys[SDL_SCANCODE_D])
+    if (input.IsDown(InputState::Right))
         dirInput = 1;
-    bool jumpPressed = keys[SDL_SCANCODE_SPACE];
+    bool jumpPressed = input.IsDown(InputState::Jump);
 
-    if (keys[SDL_SCANCODE_E])
+    if (input.IsDown(InputState::Fire))
     {
-        if (weaponTimer.isTimeout())
+        if (player.weaponTimer.isTimeout())
         {
-            if (onShoot)
-                onShoot(this->position, this->direction);
-            weaponTimer.reset();
+            if (player.onShoot)
+                player.onShoot(store.position[i], direction);
+            player.weaponTimer.reset();
         }
     }
-    weaponTimer.step(deltaTime);
-    switch (state)
+    player.weaponTimer.step(deltaTime);
+    if (player.autoFireRate > 0.0f && player.onShoot)
+    {
+        // not bound by the weapon timer, a high rate fires several shots per tick, but
+        // never more than the pool holds: the rest would only be dropped
+        player.autoFireDue = std::min(player.autoFireDue + player.autoFireRate * deltaTime,
+                                      static_cast<float>(BulletPool::DefaultCapacity));
+        for (; player.autoFireDue >= 1.0f; player.autoFireDue -= 1.0f)
+            player.onShoot(store.position[i], direction);
+    }
+
+    bool grounded = store.Has(i, EntityStore::Grounded);
+    switch (player.state)
     {
         case PlayerState::Idle:
-            if (jumpPressed && this->isGrounded())
+            if (jumpPressed && grounded)
             {
-                state = PlayerState::Jumping;
+                player.state = PlayerState::Jumping;
                 velocity.y = jump_power;
-                this->setGrounded(false);
+                grounded = false;
             }
             else if (dirInput != 0)
             {
-                state = PlayerState::Running;
+                player.state = PlayerState::Running;
             }
-            currentAnim = 0;
+            store.SetClip(i, ClipId::PlayerIdle);
             break;
         case PlayerState::Running:
-            if (jumpPressed && this->isGrounded())
+            if (jumpPressed && grounded)
             {
-                state = PlayerState::Jumping;
+                player.state = PlayerState::Jumping;
                 velocity.y = jump_power;
-                this->setGrounded(false);
+                grounded = false;
             }
             else if (dirInput == 0 && std::abs(velocity.x) < 5.0f)
             {
-                state = PlayerState::Idle;
+                player.state = PlayerState::Idle;
             }
-            else if (velocity.x * direction < 0 && this->isGrounded())
+            else if (velocity.x * direction < 0 && grounded)
             {
-                currentAnim = 3;
+                store.SetClip(i, ClipId::PlayerSlide);
             }
             else
             {
-                currentAnim = 1;
+                store.SetClip(i, ClipId::PlayerRun);
             }
 
             break;
         case PlayerState::Jumping:
-            if (this->isGrounded())
+            if (grounded)
             {
                 if (dirInput != 0)
-                    state = PlayerState::Running;
+                    player.state = PlayerState::Running;
                 else
-                    state = PlayerState::Idle;
+                    player.state = PlayerState::Idle;
             }
-            currentAnim = 2;
+            store.SetClip(i, ClipId::PlayerJump);
             break;
     }
+    store.state[i] = static_cast<uint8_t>(player.state);
 
     if (dirInput != 0)
         direction = dirInput;
@@ -96,7 +120,7 @@ void Player::update(float deltaTime, const bool* keys)
 
     velocity.x = velocity.x + (dirInput * acceleration.x * deltaTime);
 
-    this->grounded = false;
+    store.Set(i, EntityStore::Grounded, false);
     if (std::abs(velocity.x) > maxSpeedX)
     {
         velocity.x = (velocity.x > 0 ? 1.0f : -1.0f) * maxSpeedX;
@@ -117,23 +141,4 @@ void Player::update(float deltaTime, const bool* keys)
             velocity.x += amount;
         }
     }
-    if (!animations.empty())
-    {
-        animations[currentAnim].step(deltaTime);
-    }
-
-    GameObject::update(deltaTime, keys);
-}
-
-void Player::Render(SDL_Renderer* renderer, glm::vec2 offset)
-{
-    if (animations.empty())
-        return;
-
-    SDL_FRect src = animations[currentAnim].GetCurrentFrameSrc();
-
-    SDL_FRect dst = {position.x + offset.x, position.y + offset.y, src.w, src.h};
-
-    SDL_FlipMode flip = (direction == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-    SDL_RenderTextureRotated(renderer, texture, &src, &dst, 0, nullptr, flip);
 }
@@ -1,41 +1,36 @@
 #pragma once
+#include <SDL3/SDL_render.h>
+
+#include <cstdint>
 #include <functional>
-#include <glm/fwd.hpp>
-#include <vector>
+#include <glm/glm.hpp>
 
-#include "core/animation.h"
+#include "core/input.h"
 #include "core/timer.h"
-#include "gameobject.h"
+#include "entityStore.h"
 
-enum class PlayerState
+enum class PlayerState : uint8_t
 {
     Idle,
     Running,
     Jumping,
 };
 
-class Player : public GameObject
+// The player is a body in the EntityStore plus this controller; there is only one,
+// so its input and weapon state do not need columns of their own.
+struct PlayerController
 {
-   private:
+    uint32_t entity = 0;
     PlayerState state = PlayerState::Idle;
-
-    // constants for the player
-    float maxSpeedX = 80.0f;
-    float direction = 1.0f;
-    glm::vec2 acceleration{250.0f, 0.0f};
-    float jump_power = -300.0f;
-    std::vector<Animation> animations;
-    int currentAnim = 0;
-    bool grounded = true;
     Timer weaponTimer{0.2f};
-    float gravity = 500.0f;
-
-   public:
+    // shots per second fired without input (stress scenes), 0 leaves it to Fire
+    float autoFireRate = 0.0f;
+    // shots owed so far, whole ones are fired each tick
+    float autoFireDue = 0.0f;
     std::function<void(glm::vec2, float)> onShoot;
-    Player(SDL_Texture* atlasTexture);
-    PlayerState getState() { return state; }
-    void update(float deltaTime, const bool* keys) override;
-    void Render(SDL_Renderer* renderer, glm::vec2 offset) override;
-    void setGrounded(bool val) { grounded = val; }
-    bool isGrounded() { return grounded; }
 };
+
+uint32_t SpawnPlayer(EntityStore& store, PlayerController& player, const AtlasRegion& sheet,
+                     glm::vec2 position);
+void UpdatePlayer(EntityStore& store, PlayerController& player, float deltaTime,
+                  const InputState& input);
@@ -0,0 +1,152 @@
+#include "stressScene.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "bullet.h"
+#include "core/appConfig.h"
+#include "levelFile.h"
+
+// tile ids, as registered in Level::LoadMap
+static const uint16_t GROUND = 1;
+static const uint16_t PANEL = 2;
+static const uint16_t BRICK = 6;
+// columns on the left kept free of platforms and enemies, the player starts there
+static const uint32_t SPAWN_COLS = 6;
+static const uint32_t MIN_COLS = 16;
+static const uint32_t MIN_ROWS = 6;
+// the converter's limits: at most 2^20 cells a side, and the cells, every spawn and the
+// two parallax lines within one level image
+static const uint32_t MAX_SIDE = 1u << 20;
+static const uint32_t MAX_ENEMIES = 1000000;
+static const uint64_t MAX_CELLS =
+    (LEVEL_MAX_IMAGE_BYTES - sizeof(LevelHeader) - (MAX_ENEMIES + 1) * sizeof(LevelSpawn) -
+     2 * sizeof(LevelParallax) - 16) /
+    LevelLayerBytes(1, 1);
+// a full bullet pool every tick at the highest tick rate, anything faster only drops shots
+static const float MAX_FIRE_RATE = static_cast<float>(BulletPool::DefaultCapacity) * MAX_TICK_HZ;
+
+static void AppendLayer(std::string& text, const char* name, const std::vector<uint16_t>& cells,
+                        uint32_t cols)
+{
+    text += "layer ";
+    text += name;
+    text += "\n";
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        text += std::to_string(cells[i]);
+        text += (i + 1) % cols == 0 ? '\n' : ',';
+    }
+}
+
+std::string GenerateStressScene(const StressSceneParams& params, uint64_t seed)
+{
+    const uint32_t cols = params.cols;
+    const uint32_t rows = params.rows;
+    const uint32_t floorRow = rows - 1;
+    uint64_t rng = seed;
+    std::vector<uint16_t> level(size_t(cols) * rows, 0);
+    std::vector<uint16_t> background(size_t(cols) * rows, 0);
+    auto at = [cols](std::vector<uint16_t>& cells, uint32_t c, uint32_t r) -> uint16_t&
+    { return cells[size_t(r) * cols + c]; };
+
+    for (uint32_t c = 0; c < cols; c++)
+    {
+        at(level, c, floorRow) = GROUND;
+        // a brick pillar every few columns behind the floor, like the built-in level
+        for (uint32_t r = floorRow - 2; c % 5 == 0 && r < floorRow; r++)
+            at(background, c, r) = BRICK;
+    }
+
+    // platforms of 3 to 8 panels between the second row and two rows over the floor,
+    // until the density is reached; overlapping runs make a dense map take longer
+    const size_t target = static_cast<size_t>(
+        std::clamp(params.density, 0.0f, 0.9f) * float(cols - SPAWN_COLS) * float(floorRow - 3));
+    size_t solid = 0;
+    for (size_t attempt = 0; solid < target && attempt < target * 8; attempt++)
+    {
+        uint32_t length = 3 + SDL_rand_r(&rng, 6);
+        uint32_t c0 = SPAWN_COLS + SDL_rand_r(&rng, cols - SPAWN_COLS);
+        uint32_t r = 1 + SDL_rand_r(&rng, floorRow - 3);
+        for (uint32_t c = c0; c < std::min(c0 + length, cols) && solid < target; c++)
+        {
+            if (at(level, c, r) == 0)
+            {
+                at(level, c, r) = PANEL;
+                solid++;
+            }
+        }
+    }
+
+    std::string text = "# generated stress scene\nsize " + std::to_string(cols) + " " +
+                       std::to_string(rows) + "\ntile 32\norigin 0 0\n";
+    text += "parallax background_1 0 0\nparallax background_2 0.5 220\n";
+    text += "spawn player 2 " + std::to_string(floorRow - 1) + "\n";
+
+    // evenly over the width, each on a random surface of its column
+    std::vector<uint32_t> surfaces;
+    for (uint32_t e = 0; e < params.enemies; e++)
+    {
+        uint32_t c = SPAWN_COLS + static_cast<uint32_t>(uint64_t(e) * (cols - SPAWN_COLS) /
+                                                        params.enemies);
+        surfaces.clear();
+        for (uint32_t r = 0; r < floorRow; r++)
+        {
+            if (at(level, c, r) == 0 && at(level, c, r + 1) != 0)
+                surfaces.push_back(r);
+        }
+        uint32_t row = surfaces[SDL_rand_r(&rng, static_cast<int>(surfaces.size()))];
+        text += "spawn enemy " + std::to_string(c) + " " + std::to_string(row) + "\n";
+    }
+
+    AppendLayer(text, "background", background, cols);
+    AppendLayer(text, "level", level, cols);
+    return text;
+}
+
+bool ParseStressScene(const std::string& text, StressSceneParams& params)
+{
+    const char* cursor = text.c_str();
+    char* end = nullptr;
+    unsigned long cols = std::strtoul(cursor, &end, 10);
+    bool ok = end != cursor && *end == 'x';
+    unsigned long rows = ok ? std::strtoul(cursor = end + 1, &end, 10) : 0;
+    ok = ok && end != cursor;
+    if (ok && *end == ',')
+    {
+        params.density = std::strtof(cursor = end + 1, &end);
+        ok = end != cursor && params.density >= 0.0f && params.density <= 0.9f;
+    }
+    if (ok && *end == ',')
+    {
+        unsigned long enemies = std::strtoul(cursor = end + 1, &end, 10);
+        ok = end != cursor && enemies <= MAX_ENEMIES;
+        params.enemies = static_cast<uint32_t>(enemies);
+    }
+    if (ok && *end == ',')
+    {
+        params.fireRate = std::strtof(cursor = end + 1, &end);
+        ok = end != cursor && std::isfinite(params.fireRate) && params.fireRate >= 0.0f &&
+             params.fireRate <= MAX_FIRE_RATE;
+    }
+    ok = ok && *end == '\0' && cols >= MIN_COLS && rows >= MIN_ROWS && cols <= MAX_SIDE &&
+         rows <= MAX_SIDE && uint64_t(cols) * rows <= MAX_CELLS;
+    if (!ok)
+    {
+        SDL_Log("Invalid stress scene \"%s\", expected COLSxROWS[,DENSITY[,ENEMIES[,FIRE_RATE]]] "
+                "with %ux%u to %ux%u cells, at most %llu in all, a density up to 0.9, up "
+                "to %u enemies and up to %.0f shots per second",
+                text.c_str(), MIN_COLS, MIN_ROWS, MAX_SIDE, MAX_SIDE,
+                static_cast<unsigned long long>(MAX_CELLS), MAX_ENEMIES,
+                static_cast<double>(MAX_FIRE_RATE));
+        return false;
+    }
+    params.cols = static_cast<uint32_t>(cols);
+    params.rows = static_cast<uint32_t>(rows);
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// knobs of a generated stress level, see GenerateStressScene
+struct StressSceneParams
+{
+    uint32_t cols = 256;
+    uint32_t rows = 32;
+    // share of the cells above the floor that are solid, laid out as platforms
+    float density = 0.05f;
+    uint32_t enemies = 1000;
+    // player shots per second without any input, 0 leaves it to the Fire button
+    float fireRate = 0.0f;
+};
+
+// Level text of a stress scene: a floor along the bottom, random platforms up to the
+// density, the player on the left and the enemies spread evenly over the whole width,
+// each standing on the floor or a platform. Only the chunks around the camera are
+// simulated, so a map a few screens wide keeps every enemy awake. The same params and
+// seed give the same level.
+std::string GenerateStressScene(const StressSceneParams& params, uint64_t seed);
+
+// "COLSxROWS[,DENSITY[,ENEMIES[,FIRE_RATE]]]", fields left out keep their value. Sizes the
+// level format cannot hold are rejected, the message gives the limits
+bool ParseStressScene(const std::string& text, StressSceneParams& params);
@@ -0,0 +1,173 @@
+#include "tileGrid.h"
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <algorithm>
+#include <cmath>
+
+void TileGrid::Resize(int cols, int rows, float tileSize, glm::vec2 origin, const TileSet* set)
+{
+    ownedTiles.assign(static_cast<size_t>(cols) * rows, 0);
+    AttachTiles(cols, rows, tileSize, origin, set, ownedTiles.data());
+}
+
+void TileGrid::AttachTiles(int cols, int rows, float tileSize, glm::vec2 origin,
+                           const TileSet* set, uint16_t* data)
+{
+    if (data != ownedTiles.data())
+        ownedTiles.clear();
+    this->cols = cols;
+    this->rows = rows;
+    this->tileSize = tileSize;
+    this->origin = origin;
+    this->tileSet = set;
+    tiles = data;
+    chunkRevision.assign(static_cast<size_t>(GetChunkCols()) * GetChunkRows(), 0);
+    chunkFilled.assign(chunkRevision.size(), 0);
+    filledChunks = 0;
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            if (tiles[r * cols + c] != 0)
+                CountFilled(c, r, 1);
+        }
+    }
+}
+
+void TileGrid::CountFilled(int c, int r, int delta)
+{
+    uint32_t& filled = chunkFilled[(r / CHUNK_TILES) * GetChunkCols() + c / CHUNK_TILES];
+    filledChunks += (filled == 0 && delta > 0);
+    filled += delta;
+    filledChunks -= (filled == 0 && delta < 0);
+}
+
+CellRange TileGrid::GetOverlappingCells(const SDL_FRect& rect) const
+{
+    // ceil - 1 on the min side keeps the neighbour whose far edge exactly touches the rect
+    int c0 = static_cast<int>(std::ceil((rect.x - origin.x) / tileSize)) - 1;
+    int r0 = static_cast<int>(std::ceil((rect.y - origin.y) / tileSize)) - 1;
+    int c1 = static_cast<int>(std::floor((rect.x + rect.w - origin.x) / tileSize));
+    int r1 = static_cast<int>(std::floor((rect.y + rect.h - origin.y) / tileSize));
+
+    return {std::max(c0, 0), std::max(r0, 0), std::min(c1, cols - 1), std::min(r1, rows - 1)};
+}
+
+CellRange TileGrid::GetChunkCells(int cx, int cy) const
+{
+    int c0 = cx * CHUNK_TILES;
+    int r0 = cy * CHUNK_TILES;
+    return {c0, r0, std::min(c0 + CHUNK_TILES, cols) - 1, std::min(r0 + CHUNK_TILES, rows) - 1};
+}
+
+SDL_FRect TileGrid::GetChunkRect(int cx, int cy) const
+{
+    CellRange range = GetChunkCells(cx, cy);
+    return {origin.x + range.c0 * tileSize, origin.y + range.r0 * tileSize,
+            (range.c1 - range.c0 + 1) * tileSize, (range.r1 - range.r0 + 1) * tileSize};
+}
+
+bool TileGrid::OverlapsSolid(const SDL_FRect& rect) const
+{
+    CellRange range = GetOverlappingCells(rect);
+    for (int r = range.r0; r <= range.r1; r++)
+    {
+        for (int c = range.c0; c <= range.c1; c++)
+        {
+            if (!IsSolid(c, r))
+                continue;
+
+            SDL_FRect tileRect = GetTileRect(c, r);
+            SDL_FRect intersection;
+            if (SDL_GetRectIntersectionFloat(&tileRect, &rect, &intersection))
+                return true;
+        }
+    }
+    return false;
+}
+
+SweepHit TileGrid::SweepSolid(const SDL_FRect& box, glm::vec2 delta, bool* startsInside) const
+{
+    SweepHit first;
+    ForEachSolidTile(SweptBounds(box, delta),
+                     [&](const SDL_FRect& tileRect)
+                     {
+                         // the earliest tile stops the box, on a tie a floor beats a seam
+                         SweepHit hit;
+                         if (SweepBox(box, delta, tileRect, hit))
+                         {
+                             if (!first.IsHit() || hit.time < first.time ||
+                                 (hit.time == first.time && hit.normal.y != 0.0f))
+                                 first = hit;
+                         }
+                         else if (startsInside && box.x < tileRect.x + tileRect.w - SWEEP_SKIN &&
+                                  tileRect.x < box.x + box.w - SWEEP_SKIN &&
+                                  box.y < tileRect.y + tileRect.h - SWEEP_SKIN &&
+                                  tileRect.y < box.y + box.h - SWEEP_SKIN)
+                         {
+                             *startsInside = true;
+                         }
+                     });
+    return first;
+}
+
+bool TileGrid::IsEmpty(CellRange range) const
+{
+    for (int r = range.r0; r <= range.r1; r++)
+    {
+        for (int c = range.c0; c <= range.c1; c++)
+        {
+            if (tiles[r * cols + c] != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+void TileGrid::RenderCells(SpriteBatch& batch, CellRange range, glm::vec2 offset) const
+{
+    for (int r = range.r0; r <= range.r1; r++)
+    {
+        for (int c = range.c0; c <= range.c1; c++)
+        {
+            const AtlasRegion& sprite = tileSet->Get(tiles[r * cols + c]).sprite;
+            if (!sprite.texture)
+                continue;
+
+            SDL_FRect dst = GetTileRect(c, r);
+            dst.x += offset.x;
+            dst.y += offset.y;
+            batch.Draw(sprite.texture, &sprite.rect, dst);
+        }
+    }
+}
+
+TileContact ResolveTileOverlap(glm::vec2& position, glm::vec2& velocity, SDL_FRect intersection)
+{
+    // Horizontal Collision
+    if (intersection.w < intersection.h)
+    {
+        if (velocity.x > 0)
+            position.x -= intersection.w;
+        else if (velocity.x < 0)
+            position.x += intersection.w;
+        velocity.x = 0;
+        return TileContact::Side;
+    }
+    // Vertical Collision
+    if (velocity.y > 0)
+    {
+        position.y -= intersection.h;
+        velocity.y = 0;
+        return TileContact::Floor;
+    }
+    if (velocity.y < 0)
+    {
+        position.y += intersection.h;
+        velocity.y = 0;
+        return TileContact::Ceiling;
+    }
+    return TileContact::None;
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "core/atlasPacker.h"
+#include "core/spriteBatch.h"
+#include "core/sweep.h"
+
+// per tile type data shared by every cell of that type
+struct TileProperties
+{
+    AtlasRegion sprite;
+    bool solid = false;
+};
+
+class TileSet
+{
+    std::vector<TileProperties> types;
+
+   public:
+    void Register(uint16_t type, TileProperties props)
+    {
+        if (type >= types.size())
+            types.resize(type + 1);
+        types[type] = props;
+    }
+    const TileProperties& Get(uint16_t type) const
+    {
+        static const TileProperties empty;
+        return type < types.size() ? types[type] : empty;
+    }
+};
+
+// inclusive range of grid cells, empty when c0 > c1 or r0 > r1
+struct CellRange
+{
+    int c0, r0, c1, r1;
+};
+
+// which side of a tile a resolved body ended up against
+enum class TileContact
+{
+    None,
+    Side,
+    Floor,
+    Ceiling,
+};
+
+// Pushes a body out of a tile along the shallower overlap axis and stops it on that axis.
+TileContact ResolveTileOverlap(glm::vec2& position, glm::vec2& velocity, SDL_FRect intersection);
+
+// Dense grid of tile type ids (0 = empty). Static level geometry lives here instead of
+// one GameObject per tile, so queries only touch the cells a rect overlaps.
+class TileGrid
+{
+   public:
+    // tiles per side of a chunk, the unit the render cache bakes
+    static const int CHUNK_TILES = 16;
+
+   private:
+    int cols = 0;
+    int rows = 0;
+    float tileSize = 32.0f;
+    glm::vec2 origin{0.0f};
+    const TileSet* tileSet = nullptr;
+    std::vector<uint16_t> ownedTiles;
+    // ownedTiles or a view into a loaded level file
+    uint16_t* tiles = nullptr;
+    // bumped whenever SetTile changes a cell of the chunk
+    std::vector<uint32_t> chunkRevision;
+    // non-empty cells per chunk and the chunks with any, kept up to date by SetTile
+    std::vector<uint32_t> chunkFilled;
+    uint32_t filledChunks = 0;
+
+    void CountFilled(int c, int r, int delta);
+
+   public:
+    void Resize(int cols, int rows, float tileSize, glm::vec2 origin, const TileSet* set);
+    // uses cols * rows ids at data in place, the caller keeps them alive and writable
+    void AttachTiles(int cols, int rows, float tileSize, glm::vec2 origin, const TileSet* set,
+                     uint16_t* data);
+
+    int GetCols() const { return cols; }
+    int GetRows() const { return rows; }
+    float GetTileSize() const { return tileSize; }
+    glm::vec2 GetOrigin() const { return origin; }
+    SDL_FRect GetBounds() const { return {origin.x, origin.y, cols * tileSize, rows * tileSize}; }
+
+    uint16_t GetTile(int c, int r) const
+    {
+        if (c < 0 || r < 0 || c >= cols || r >= rows)
+            return 0;
+        return tiles[r * cols + c];
+    }
+    void SetTile(int c, int r, uint16_t type)
+    {
+        if (c < 0 || r < 0 || c >= cols || r >= rows || tiles[r * cols + c] == type)
+            return;
+        CountFilled(c, r, (type != 0) - (tiles[r * cols + c] != 0));
+        tiles[r * cols + c] = type;
+        chunkRevision[(r / CHUNK_TILES) * GetChunkCols() + c / CHUNK_TILES]++;
+    }
+    bool IsSolid(int c, int r) const { return tileSet->Get(GetTile(c, r)).solid; }
+
+    SDL_FRect GetTileRect(int c, int r) const
+    {
+        return {origin.x + c * tileSize, origin.y + r * tileSize, tileSize, tileSize};
+    }
+
+    // Cells touched by rect, clamped to the grid. Edges count as touching to match
+    // SDL_GetRectIntersectionFloat, which reports zero-width overlaps.
+    CellRange GetOverlappingCells(const SDL_FRect& rect) const;
+
+    // calls fn(tileRect) for every solid cell the rect touches, in row-major order
+    template <typename Fn>
+    void ForEachSolidTile(const SDL_FRect& rect, Fn&& fn) const
+    {
+        CellRange range = GetOverlappingCells(rect);
+        for (int r = range.r0; r <= range.r1; r++)
+        {
+            for (int c = range.c0; c <= range.c1; c++)
+            {
+                if (IsSolid(c, r))
+                    fn(GetTileRect(c, r));
+            }
+        }
+    }
+
+    int GetChunkCols() const { return (cols + CHUNK_TILES - 1) / CHUNK_TILES; }
+    int GetChunkRows() const { return (rows + CHUNK_TILES - 1) / CHUNK_TILES; }
+    uint32_t GetChunkRevision(int cx, int cy) const
+    {
+        return chunkRevision[cy * GetChunkCols() + cx];
+    }
+    bool IsChunkEmpty(int cx, int cy) const { return chunkFilled[cy * GetChunkCols() + cx] == 0; }
+    uint32_t GetFilledChunkCount() const { return filledChunks; }
+    // cells of a chunk, edge chunks are cut off at the grid border
+    CellRange GetChunkCells(int cx, int cy) const;
+    SDL_FRect GetChunkRect(int cx, int cy) const;
+
+    bool OverlapsSolid(const SDL_FRect& rect) const;
+    // First solid tile box meets on its way to box + delta, no hit when the way is
+    // clear. Tiles box already overlaps are skipped (see SweepBox) and reported
+    // through startsInside when it is given.
+    SweepHit SweepSolid(const SDL_FRect& box, glm::vec2 delta,
+                        bool* startsInside = nullptr) const;
+    // true when no cell in range holds a tile
+    bool IsEmpty(CellRange range) const;
+    void RenderCells(SpriteBatch& batch, CellRange range, glm::vec2 offset) const;
+};
@@ -0,0 +1,141 @@
+#include "tileLayerCache.h"
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_render.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/profiler.h"
+
+TileLayerCache::~TileLayerCache()
+{
+    for (Chunk& chunk : chunks)
+        SDL_DestroyTexture(chunk.texture);
+}
+
+void TileLayerCache::Attach(const TileGrid* tileGrid)
+{
+    for (Chunk& chunk : chunks)
+        SDL_DestroyTexture(chunk.texture);
+    grid = tileGrid;
+    chunks.assign(static_cast<size_t>(grid->GetChunkCols()) * grid->GetChunkRows(), Chunk{});
+    bakeCount = 0;
+}
+
+void TileLayerCache::Invalidate()
+{
+    for (Chunk& chunk : chunks)
+        chunk.baked = false;
+}
+
+void TileLayerCache::Prebake(SDL_Renderer* renderer, SpriteBatch& batch, int cx, int cy)
+{
+    Chunk& chunk = chunks[cy * grid->GetChunkCols() + cx];
+    if (!directDraw && (!chunk.baked || chunk.revision != grid->GetChunkRevision(cx, cy)))
+        Bake(renderer, batch, cx, cy, chunk);
+}
+
+void TileLayerCache::Release(SpriteBatch& batch, int cx, int cy)
+{
+    Chunk& chunk = chunks[cy * grid->GetChunkCols() + cx];
+    batch.Forget(chunk.texture);
+    SDL_DestroyTexture(chunk.texture);
+    chunk = Chunk{};
+}
+
+bool TileLayerCache::Bake(SDL_Renderer* renderer, SpriteBatch& batch, int cx, int cy,
+                          Chunk& chunk)
+{
+    PROFILE_ZONE("TileLayerCache::Bake");
+    CellRange cells = grid->GetChunkCells(cx, cy);
+    chunk.revision = grid->GetChunkRevision(cx, cy);
+    chunk.baked = true;
+    bakeCount++;
+    if (grid->IsEmpty(cells))
+    {
+        batch.Forget(chunk.texture);
+        SDL_DestroyTexture(chunk.texture);
+        chunk.texture = nullptr;
+        return true;
+    }
+
+    SDL_FRect rect = grid->GetChunkRect(cx, cy);
+    if (!chunk.texture)
+    {
+        chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                          SDL_TEXTUREACCESS_TARGET, static_cast<int>(rect.w),
+                                          static_cast<int>(rect.h));
+        if (!chunk.texture)
+        {
+            SDL_Log("Tile chunk texture failed: %s", SDL_GetError());
+            chunk.baked = false;
+            directDraw = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(chunk.texture, SDL_SCALEMODE_NEAREST);
+        // the chunk is one quad, claim its bucket now rather than on the first frame it shows
+        batch.Reserve(chunk.texture, 1);
+    }
+
+    // quads queued so far belong to the current target, submit them before switching
+    batch.Flush(renderer);
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, chunk.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    grid->RenderCells(batch, cells, {-rect.x, -rect.y});
+    batch.Flush(renderer);
+    SDL_SetRenderTarget(renderer, previous);
+    return true;
+}
+
+void TileLayerCache::Render(SDL_Renderer* renderer, SpriteBatch& batch, const SDL_FRect& view,
+                            glm::vec2 offset, CullStats& cull)
+{
+    if (!grid || chunks.empty())
+        return;
+
+    // chunk range under the view, same edge rule as TileGrid::GetOverlappingCells
+    glm::vec2 origin = grid->GetOrigin();
+    float chunkSize = grid->GetTileSize() * TileGrid::CHUNK_TILES;
+    int cx0 = std::max(static_cast<int>(std::floor((view.x - origin.x) / chunkSize)), 0);
+    int cy0 = std::max(static_cast<int>(std::floor((view.y - origin.y) / chunkSize)), 0);
+    int cx1 = std::min(static_cast<int>(std::floor((view.x + view.w - origin.x) / chunkSize)),
+                       grid->GetChunkCols() - 1);
+    int cy1 = std::min(static_cast<int>(std::floor((view.y + view.h - origin.y) / chunkSize)),
+                       grid->GetChunkRows() - 1);
+
+    // empty chunks have nothing to draw, they count neither as visible nor as culled
+    const int chunkCols = grid->GetChunkCols();
+    uint32_t inView = 0;
+    for (int cy = cy0; cy <= cy1; cy++)
+    {
+        for (int cx = cx0; cx <= cx1; cx++)
+        {
+            if (grid->IsChunkEmpty(cx, cy))
+                continue;
+            inView++;
+            Chunk& chunk = chunks[cy * chunkCols + cx];
+            if (!chunk.baked || chunk.revision != grid->GetChunkRevision(cx, cy))
+            {
+                if (directDraw || !Bake(renderer, batch, cx, cy, chunk))
+                {
+                    // no render targets, draw the tiles directly
+                    grid->RenderCells(batch, grid->GetChunkCells(cx, cy), offset);
+                    continue;
+                }
+            }
+            if (!chunk.texture)
+                continue;
+
+            SDL_FRect dst = grid->GetChunkRect(cx, cy);
+            dst.x += offset.x;
+            dst.y += offset.y;
+            batch.Draw(chunk.texture, nullptr, dst);
+        }
+    }
+    cull.visible += inView;
+    cull.culled += grid->GetFilledChunkCount() - inView;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "core/camera.h"
+#include "core/spriteBatch.h"
+#include "tileGrid.h"
+
+// Bakes a TileGrid into one render-target texture per chunk, so a static layer
+// costs one quad per visible chunk instead of one per tile. A chunk is baked the
+// first time it is seen and again only after its revision in the grid changes.
+class TileLayerCache
+{
+    struct Chunk
+    {
+        SDL_Texture* texture = nullptr;
+        uint32_t revision = 0;
+        bool baked = false;
+    };
+
+    const TileGrid* grid = nullptr;
+    std::vector<Chunk> chunks;
+    uint32_t bakeCount = 0;
+    // set once the renderer refused a target texture, tiles are then drawn directly
+    bool directDraw = false;
+
+    bool Bake(SDL_Renderer* renderer, SpriteBatch& batch, int cx, int cy, Chunk& chunk);
+
+   public:
+    TileLayerCache() = default;
+    ~TileLayerCache();
+    TileLayerCache(const TileLayerCache&) = delete;
+    TileLayerCache& operator=(const TileLayerCache&) = delete;
+
+    // call after the grid is resized, drops every chunk
+    void Attach(const TileGrid* tileGrid);
+    // forget baked contents, e.g. after the renderer lost its targets
+    void Invalidate();
+    // bakes one chunk ahead of time if it is stale, so it is ready when it scrolls in
+    void Prebake(SDL_Renderer* renderer, SpriteBatch& batch, int cx, int cy);
+    // frees the texture of a chunk that streamed out, it is baked again when needed
+    void Release(SpriteBatch& batch, int cx, int cy);
+    // draws the chunks overlapping view (world space) shifted by offset; filled chunks
+    // off screen are counted as culled without being visited, empty ones not at all
+    void Render(SDL_Renderer* renderer, SpriteBatch& batch, const SDL_FRect& view,
+                glm::vec2 offset, CullStats& cull);
+
+    // chunks baked since Attach, a steady scene stops adding to this
+    uint32_t GetBakeCount() const { return bakeCount; }
+};
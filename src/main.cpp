@@ -1,14 +1,38 @@
+#include "core/appConfig.h"
 #include "core/application.h"
+#include "core/profiler.h"
+#include "game/levelFile.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+    AppConfig config;
+    if (!ParseCommandLine(argc, argv, config))
+        return 1;
+
+    if (!config.convertInput.empty())
+        return ConvertLevelFile(config.convertInput, config.convertOutput) ? 0 : 1;
+
+    PROFILE_THREAD("main");
+    if (!config.tracePath.empty())
+    {
+        if (Profiler::CompiledIn)
+            Profiler::Start();
+        else
+            SDL_Log("Built without GALAXY_PROFILE, %s will be empty", config.tracePath.c_str());
+    }
+
     Application app;
 
-    if (app.Initialize())
+    if (!app.Initialize(config))
     {
-        app.Run();
+        app.Destroy();
+        return 1;
     }
 
+    bool passed = app.Run();
     app.Destroy();
-    return 0;
+    // after Destroy every worker thread has been joined
+    if (!config.tracePath.empty() && !Profiler::WriteTrace(config.tracePath))
+        return 1;
+    return passed ? 0 : 1;
 }